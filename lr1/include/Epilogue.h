@@ -0,0 +1,47 @@
+#ifndef EPILOGUE_H
+#define EPILOGUE_H
+
+#include "Matrix.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+enum class Activation {
+    None,
+    ReLU,
+    Clamp
+};
+
+// C = act(alpha * A*B + beta * C + rowBias[i] + colBias[j]); empty bias vectors are skipped
+struct Epilogue {
+    double alpha = 1.0;
+    double beta = 0.0;
+    std::vector<double> rowBias;
+    std::vector<double> colBias;
+    Activation activation = Activation::None;
+    double clampMin = 0.0;
+    double clampMax = 0.0;
+
+    double apply(double product, double c, size_t i, size_t j) const {
+        double v = alpha * product;
+        if (beta != 0.0) v += beta * c;
+        if (!rowBias.empty()) v += rowBias[i];
+        if (!colBias.empty()) v += colBias[j];
+
+        switch (activation) {
+        case Activation::ReLU:
+            return std::max(v, 0.0);
+        case Activation::Clamp:
+            return std::clamp(v, clampMin, clampMax);
+        default:
+            return v;
+        }
+    }
+
+    // reference unfused version: separate passes over C for scaling, bias and activation
+    void applySeparately(const Matrix& product, Matrix& C) const;
+
+    static Activation parseActivation(const std::string& name);
+};
+
+#endif //EPILOGUE_H
@@ -0,0 +1,48 @@
+#ifndef HUGE_PAGE_ALLOCATOR_H
+#define HUGE_PAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <string>
+
+enum class MatrixBacking {
+    Default,
+    HugeTlb,
+    TransparentHuge
+};
+
+// Backing store for matrix buffers. When enabled, buffers of at least one huge page are mapped
+// with MAP_HUGETLB, falling back to huge-page aligned memory advised with MADV_HUGEPAGE.
+class HugePages {
+public:
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    static void setEnabled(bool enabled);
+    static bool enabled();
+
+    static void* allocate(size_t bytes);
+    static void deallocate(void* p, size_t bytes);
+
+    // bytes handed out per backing since startup
+    static size_t bytesAllocated(MatrixBacking backing);
+    static std::string report();
+};
+
+template <typename T>
+struct HugePageAllocator {
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(HugePages::allocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) { HugePages::deallocate(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) { return false; }
+
+#endif //HUGE_PAGE_ALLOCATOR_H
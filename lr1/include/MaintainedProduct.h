@@ -0,0 +1,39 @@
+#ifndef MAINTAINED_PRODUCT_H
+#define MAINTAINED_PRODUCT_H
+
+#include "Matrix.h"
+#include "MatrixMultiplier.h"
+#include <vector>
+
+// Keeps C = A * B up to date while rows of A and rows/columns of B are replaced.
+class MaintainedProduct {
+public:
+    MaintainedProduct(const Matrix& A, const Matrix& B, size_t numThreads, size_t blockSize = 64);
+
+    const Matrix& left() const;
+    const Matrix& right() const;
+    const Matrix& result() const;
+
+    // newRows is rows.size() x A.numCols(); recomputes the same rows of C
+    void updateRowsA(const std::vector<size_t>& rows, const Matrix& newRows);
+    // newCols is B.numRows() x cols.size(); recomputes the same columns of C
+    void updateColsB(const std::vector<size_t>& cols, const Matrix& newCols);
+    // newRows is rows.size() x B.numCols(); rank-k correction C += A(:, rows) * (new - old)
+    void updateRowsB(const std::vector<size_t>& rows, const Matrix& newRows);
+    // full recompute, e.g. to drop rounding drift accumulated by rank-k corrections
+    void recomputeAll();
+
+    size_t flopsPerformed() const;
+    size_t flopsSaved() const;
+
+private:
+    Matrix A, B, C;
+    MatrixMultiplier multiplier;
+    size_t numThreads;
+    size_t performed = 0;
+    size_t saved = 0;
+
+    void account(size_t flops);
+};
+
+#endif //MAINTAINED_PRODUCT_H
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <random>
 #include <iomanip>
+#include "HugePageAllocator.h"
 
 class Matrix {
 public:
@@ -17,13 +18,14 @@ public:
     const double& operator()(size_t i, size_t j) const;
 
     void fillRandom(double minVal = 0.0, double maxVal = 10.0);
+    void zeroRandomBlocks(size_t blockSize, double ratio);
     void saveToFile(const std::string& filename) const;
     static Matrix loadFromFile(const std::string& filename);
     void print() const;
 
 private:
     size_t rows, cols;
-    std::vector<std::vector<double>> data;
+    std::vector<double, HugePageAllocator<double>> data; // row-major
 };
 
 #endif //MATRIX_H
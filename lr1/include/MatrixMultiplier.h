@@ -2,10 +2,18 @@
 #define MATRIX_MULTIPLER_H
 
 #include "Matrix.h"
+#include "QuantizedMatrix.h"
+#include "Epilogue.h"
 #include <thread>
 #include <future>
 #include <stdexcept>
 #include <chrono>
+#include <vector>
+
+struct BlockSparseStats {
+    size_t totalTileProducts = 0;
+    size_t computedTileProducts = 0;
+};
 
 class MatrixMultiplier {
 public:
@@ -14,10 +22,21 @@ public:
     static Matrix multiplySingleThread(const Matrix& A, const Matrix& B);
     Matrix multiplyMultiThread(const Matrix& A, const Matrix& B, size_t numThreads);
     Matrix multiplyAsync(const Matrix& A, const Matrix& B, size_t numTasks); 
+    Matrix multiplyBlockSparse(const Matrix& A, const Matrix& B, size_t numThreads,
+                               BlockSparseStats* stats = nullptr);
+    // C = act(alpha*A*B + beta*C + bias), applied to each output tile right after its k-loop
+    void multiplyFused(const Matrix& A, const Matrix& B, Matrix& C, const Epilogue& epilogue,
+                       size_t numThreads);
+    // Bt holds B transposed (see QuantizedMatrix::quantizeTransposed); int32 accumulation, dequantized result
+    Matrix multiplyQuantized(const QuantizedMatrix& A, const QuantizedMatrix& Bt, size_t numThreads);
+    static const char* quantizedKernelName();
     static bool areEqual(const Matrix& A, const Matrix& B, double eps = 1e-6);
 
 private:
     size_t blockSize;
+
+    // one flag per blockSize x blockSize tile, row-major, true if the tile has a nonzero
+    std::vector<bool> buildBlockMask(const Matrix& M) const;
 };
 
 #endif //MATRIX_MULTIPLIER_H
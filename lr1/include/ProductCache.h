@@ -0,0 +1,71 @@
+#ifndef PRODUCT_CACHE_H
+#define PRODUCT_CACHE_H
+
+#include "Matrix.h"
+#include "MatrixMultiplier.h"
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct ProductKey {
+    uint64_t hashA;
+    uint64_t hashB;
+    uint64_t rows; // shape of A*B, so an entry of the wrong shape never matches
+    uint64_t cols;
+
+    bool operator==(const ProductKey& other) const {
+        return hashA == other.hashA && hashB == other.hashB && rows == other.rows && cols == other.cols;
+    }
+};
+
+struct ProductKeyHash {
+    size_t operator()(const ProductKey& key) const {
+        return key.hashA ^ (key.hashB * 0x9E3779B97F4A7C15ULL);
+    }
+};
+
+// LRU cache of A*B results keyed by content hashes of A and B, bounded by result bytes.
+class ProductCache {
+public:
+    ProductCache(size_t byteBudget, size_t numThreads);
+
+    // xxHash64 of the dimensions and contents; rows are hashed in fixed chunks in parallel
+    static uint64_t hashMatrix(const Matrix& M, size_t numThreads);
+    ProductKey makeKey(const Matrix& A, const Matrix& B) const;
+
+    Matrix multiply(MatrixMultiplier& multiplier, const Matrix& A, const Matrix& B);
+    bool lookup(const ProductKey& key, Matrix& result);
+    void insert(const ProductKey& key, const Matrix& result);
+
+    void saveToFile(const std::string& filename) const;
+    // returns false if the file does not exist; entries whose dimensions do not fit the file
+    // are dropped along with the rest of it, so their products are recomputed as misses
+    bool loadFromFile(const std::string& filename);
+
+    size_t hits() const;
+    size_t misses() const;
+    size_t evictions() const;
+    size_t bytesUsed() const;
+    size_t size() const;
+
+private:
+    using Entry = std::pair<ProductKey, Matrix>;
+
+    size_t byteBudget;
+    size_t numThreads;
+    size_t used = 0;
+    size_t hitCount = 0;
+    size_t missCount = 0;
+    size_t evictionCount = 0;
+
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<ProductKey, std::list<Entry>::iterator, ProductKeyHash> index;
+    mutable std::mutex mtx;
+
+    static size_t entryBytes(const Matrix& M);
+    void insertLocked(const ProductKey& key, const Matrix& result);
+};
+
+#endif //PRODUCT_CACHE_H
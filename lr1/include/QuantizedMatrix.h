@@ -0,0 +1,43 @@
+#ifndef QUANTIZED_MATRIX_H
+#define QUANTIZED_MATRIX_H
+
+#include "Matrix.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class QuantScaleMode {
+    PerTensor,
+    PerRow
+};
+
+// Symmetric int8 quantization: value = scale * q, q in [-127, 127].
+class QuantizedMatrix {
+public:
+    QuantizedMatrix(size_t r, size_t c, QuantScaleMode mode);
+
+    static QuantizedMatrix quantize(const Matrix& M, QuantScaleMode mode);
+    // rows of the result are columns of M, so PerRow gives one scale per column of M
+    static QuantizedMatrix quantizeTransposed(const Matrix& M, QuantScaleMode mode);
+    Matrix dequantize() const;
+
+    size_t numRows() const;
+    size_t numCols() const;
+    QuantScaleMode scaleMode() const;
+
+    double scale(size_t i) const;
+    const int8_t* row(size_t i) const;
+
+    static QuantScaleMode parseMode(const std::string& name);
+
+private:
+    size_t rows, cols;
+    QuantScaleMode mode;
+    std::vector<int8_t> data;
+    std::vector<double> scales;
+
+    static QuantizedMatrix quantizeRows(size_t r, size_t c, QuantScaleMode mode,
+                                        const std::vector<double>& values);
+};
+
+#endif //QUANTIZED_MATRIX_H
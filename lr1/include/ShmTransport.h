@@ -0,0 +1,52 @@
+#ifndef SHM_TRANSPORT_H
+#define SHM_TRANSPORT_H
+
+#include "Transport.h"
+#include <cstdint>
+#include <memory>
+#include <sys/types.h>
+
+// Transport between forked processes on one host. Every (rank, tag) owns a mailbox in an
+// anonymous shared mapping; the root writes a message and bumps a sequence number, receivers
+// copy it and acknowledge, and the root waits for all acknowledgements before reusing it.
+class ShmTransport : public Transport {
+public:
+    static const int NUM_TAGS = 3;
+
+    // Forks numRanks - 1 children. The caller becomes rank 0; every process gets its own transport.
+    // capacity is the largest message in doubles.
+    static std::unique_ptr<ShmTransport> launch(int numRanks, size_t capacity);
+    ~ShmTransport() override;
+
+    int rank() const override;
+    int size() const override;
+    void broadcast(std::vector<double>& data, int root, const std::vector<int>& group, int tag) override;
+
+    // makes every rank waiting on a message throw instead of hanging
+    void fail();
+    // children exit with the given status; rank 0 waits for them and returns false if any failed
+    bool finish(int status = 0);
+
+private:
+    struct Shared;
+    struct Mailbox;
+
+    ShmTransport(void* region, size_t regionBytes, int rank, int numRanks, size_t capacity);
+
+    Mailbox* mailbox(int owner, int tag) const;
+    template <typename Pred>
+    void waitUntil(Pred ready) const;
+
+    void* region;
+    size_t regionBytes;
+    size_t mailboxBytes;
+    int rankId;
+    int numRanks;
+    size_t capacity;
+    std::vector<pid_t> children;
+    std::vector<uint64_t> sent;          // messages sent per own tag
+    std::vector<uint64_t> expectedAcks;  // acknowledgements owed per own tag
+    std::vector<uint64_t> received;      // messages consumed per (root, tag)
+};
+
+#endif //SHM_TRANSPORT_H
@@ -0,0 +1,36 @@
+#ifndef STREAMING_MULTIPLIER_H
+#define STREAMING_MULTIPLIER_H
+
+#include "Matrix.h"
+#include "MatrixMultiplier.h"
+#include <iostream>
+
+struct StreamStats {
+    size_t rows = 0;
+    size_t panels = 0;
+    double readTime = 0.0;    // busy time of each stage, seconds
+    double computeTime = 0.0;
+    double writeTime = 0.0;
+    double totalTime = 0.0;
+};
+
+// Multiplies rows of A read from a stream by a resident B. Rows are grouped into panels and
+// read, multiplied and written by three pipelined stages with at most queueDepth panels
+// waiting between stages, so memory stays O(|B| + panels).
+class StreamingMultiplier {
+public:
+    StreamingMultiplier(const Matrix& B, size_t panelRows, size_t numThreads,
+                        size_t blockSize = 64, size_t queueDepth = 2);
+
+    // input and output use the Matrix::loadFromFile / saveToFile text format
+    StreamStats run(std::istream& in, std::ostream& out);
+
+private:
+    const Matrix& B;
+    size_t panelRows;
+    size_t numThreads;
+    size_t queueDepth;
+    MatrixMultiplier multiplier;
+};
+
+#endif //STREAMING_MULTIPLIER_H
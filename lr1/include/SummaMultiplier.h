@@ -0,0 +1,33 @@
+#ifndef SUMMA_MULTIPLIER_H
+#define SUMMA_MULTIPLIER_H
+
+#include "Matrix.h"
+#include "Transport.h"
+#include <vector>
+
+struct SummaRankStats {
+    double computeTime = 0.0;
+    double commTime = 0.0;
+};
+
+// SUMMA on a gridRows x gridCols process grid: rank (pi, pj) owns block (pi, pj) of A, B and C.
+// For each k-panel the owning process column broadcasts its A panel along process rows and the
+// owning process row broadcasts its B panel along process columns.
+class SummaMultiplier {
+public:
+    explicit SummaMultiplier(size_t panelWidth = 64) : panelWidth(panelWidth) {}
+
+    // Every rank passes A and B but reads only its own blocks. Rank 0 returns the full C and fills
+    // stats for all ranks; other ranks return an empty matrix.
+    Matrix multiply(const Matrix& A, const Matrix& B, Transport& transport,
+                    std::vector<SummaRankStats>& stats) const;
+
+    // largest message in doubles, to size the transport
+    size_t messageCapacity(const Matrix& A, const Matrix& B, int numRanks) const;
+    static void gridShape(int numRanks, int& gridRows, int& gridCols);
+
+private:
+    size_t panelWidth;
+};
+
+#endif //SUMMA_MULTIPLIER_H
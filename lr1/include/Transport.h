@@ -0,0 +1,19 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <vector>
+
+// Message passing between the ranks of a distributed multiplication.
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    virtual int rank() const = 0;
+    virtual int size() const = 0;
+
+    // Copies root's data to every other member of group; all members call it with the same
+    // arguments. A (root, tag) pair must always be used with the same group, like a communicator.
+    virtual void broadcast(std::vector<double>& data, int root, const std::vector<int>& group, int tag) = 0;
+};
+
+#endif //TRANSPORT_H
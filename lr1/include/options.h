@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <getopt.h> 
 #include <iostream>
+#include <vector>
 
 
 struct Options {
@@ -16,14 +17,27 @@ struct Options {
     bool measureTime = false;
     size_t repeats = 3;
     int threads = 0;
+    std::vector<size_t> threadList; // more than one entry (or --sizes) selects the sweep mode
+    std::vector<size_t> sizes;
     std::string output;
     bool debug = false;
     std::string csv;
     size_t blockSize = 64;
+    double zeroBlocks = 0.0;
+    std::string quantize;
+    std::string epilogue;
+    size_t updates = 0;
+    size_t cacheMb = 0;
+    std::string cacheFile;
+    std::string stream;
+    size_t panelRows = 64;
+    int distributed = 0;
+    bool hugePages = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const Options& opts);
 
 Options parseOptions(int argc, char* argv[]);
+std::vector<size_t> parseList(const std::string& list);
 
 #endif //OPTIONS_H
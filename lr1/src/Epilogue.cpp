@@ -0,0 +1,36 @@
+#include "../include/Epilogue.h"
+
+#include <stdexcept>
+
+void Epilogue::applySeparately(const Matrix& product, Matrix& C) const {
+    for (size_t i = 0; i < C.numRows(); i++) {
+        for (size_t j = 0; j < C.numCols(); j++) {
+            C(i, j) = alpha * product(i, j) + beta * C(i, j);
+        }
+    }
+
+    if (!rowBias.empty() || !colBias.empty()) {
+        for (size_t i = 0; i < C.numRows(); i++) {
+            for (size_t j = 0; j < C.numCols(); j++) {
+                if (!rowBias.empty()) C(i, j) += rowBias[i];
+                if (!colBias.empty()) C(i, j) += colBias[j];
+            }
+        }
+    }
+
+    if (activation != Activation::None) {
+        for (size_t i = 0; i < C.numRows(); i++) {
+            for (size_t j = 0; j < C.numCols(); j++) {
+                C(i, j) = activation == Activation::ReLU ? std::max(C(i, j), 0.0)
+                                                         : std::clamp(C(i, j), clampMin, clampMax);
+            }
+        }
+    }
+}
+
+Activation Epilogue::parseActivation(const std::string& name) {
+    if (name == "none") return Activation::None;
+    if (name == "relu") return Activation::ReLU;
+    if (name == "clamp") return Activation::Clamp;
+    throw std::invalid_argument("error: unknown activation '" + name + "' (expected none, relu or clamp)");
+}
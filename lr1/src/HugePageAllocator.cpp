@@ -0,0 +1,98 @@
+#include "../include/HugePageAllocator.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <unordered_set>
+#include <sys/mman.h>
+
+static std::atomic<bool> hugePagesEnabled{false};
+static std::mutex registryMutex;
+static std::unordered_set<void*> hugeTlbMappings;
+static size_t allocatedBytes[3] = {0, 0, 0};
+
+static size_t roundUp(size_t n, size_t to) { return (n + to - 1) / to * to; }
+
+static void record(MatrixBacking backing, size_t bytes, void* mapping = nullptr) {
+    std::lock_guard<std::mutex> lg(registryMutex);
+    allocatedBytes[static_cast<int>(backing)] += bytes;
+    if (mapping) hugeTlbMappings.insert(mapping);
+}
+
+void HugePages::setEnabled(bool enabled) { hugePagesEnabled.store(enabled); }
+bool HugePages::enabled() { return hugePagesEnabled.load(); }
+
+void* HugePages::allocate(size_t bytes) {
+    if (!enabled() || bytes < HUGE_PAGE_SIZE) {
+        void* p = std::malloc(bytes ? bytes : 1);
+        if (!p) throw std::bad_alloc();
+        record(MatrixBacking::Default, bytes);
+        return p;
+    }
+
+    size_t rounded = roundUp(bytes, HUGE_PAGE_SIZE);
+#ifdef MAP_HUGETLB
+    void* mapped = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapped != MAP_FAILED) {
+        record(MatrixBacking::HugeTlb, bytes, mapped);
+        return mapped;
+    }
+#endif
+
+    void* p = std::aligned_alloc(HUGE_PAGE_SIZE, rounded);
+    if (!p) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    if (madvise(p, rounded, MADV_HUGEPAGE) == 0) {
+        record(MatrixBacking::TransparentHuge, bytes);
+        return p;
+    }
+#endif
+    record(MatrixBacking::Default, bytes);
+    return p;
+}
+
+void HugePages::deallocate(void* p, size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lg(registryMutex);
+        auto it = hugeTlbMappings.find(p);
+        if (it != hugeTlbMappings.end()) {
+            hugeTlbMappings.erase(it);
+            munmap(p, roundUp(bytes, HUGE_PAGE_SIZE));
+            return;
+        }
+    }
+    std::free(p);
+}
+
+size_t HugePages::bytesAllocated(MatrixBacking backing) {
+    std::lock_guard<std::mutex> lg(registryMutex);
+    return allocatedBytes[static_cast<int>(backing)];
+}
+
+// AnonHugePages shows how much advised memory the kernel actually backed with huge pages
+static std::string anonHugePages() {
+    std::ifstream in("/proc/self/smaps_rollup");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("AnonHugePages:", 0) == 0) {
+            std::istringstream fields(line.substr(14));
+            std::string value, unit;
+            fields >> value >> unit;
+            return value + " " + unit;
+        }
+    }
+    return "unknown";
+}
+
+std::string HugePages::report() {
+    const double MiB = 1024.0 * 1024.0;
+    std::ostringstream os;
+    os << "Matrix backing: hugetlb " << bytesAllocated(MatrixBacking::HugeTlb) / MiB << " MiB, "
+       << "madvise(MADV_HUGEPAGE) " << bytesAllocated(MatrixBacking::TransparentHuge) / MiB << " MiB, "
+       << "default " << bytesAllocated(MatrixBacking::Default) / MiB << " MiB"
+       << " (AnonHugePages: " << anonHugePages() << ")";
+    return os.str();
+}
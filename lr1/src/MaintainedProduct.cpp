@@ -0,0 +1,155 @@
+#include "../include/MaintainedProduct.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+template <typename Func>
+static void parallelRows(size_t n, size_t numThreads, Func worker) {
+    std::vector<std::thread> threads;
+    size_t rowsPerThread = n / numThreads;
+    size_t extra = n % numThreads;
+
+    size_t rowStart = 0;
+    for (size_t t = 0; t < numThreads; t++) {
+        size_t rowEnd = rowStart + rowsPerThread + (t < extra ? 1 : 0);
+        threads.emplace_back(worker, rowStart, rowEnd);
+        rowStart = rowEnd;
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+// index -> position of its last occurrence, so repeated indices resolve to the latest update
+static std::map<size_t, size_t> lastOccurrence(const std::vector<size_t>& indices, size_t limit) {
+    std::map<size_t, size_t> last;
+    for (size_t p = 0; p < indices.size(); p++) {
+        if (indices[p] >= limit) {
+            throw std::out_of_range("error: update index out of range");
+        }
+        last[indices[p]] = p;
+    }
+    return last;
+}
+
+MaintainedProduct::MaintainedProduct(const Matrix& A, const Matrix& B, size_t numThreads, size_t blockSize)
+    : A(A), B(B), C(A.numRows(), B.numCols()), multiplier(blockSize), numThreads(numThreads) {
+    recomputeAll();
+}
+
+const Matrix& MaintainedProduct::left() const { return A; }
+const Matrix& MaintainedProduct::right() const { return B; }
+const Matrix& MaintainedProduct::result() const { return C; }
+
+size_t MaintainedProduct::flopsPerformed() const { return performed; }
+size_t MaintainedProduct::flopsSaved() const { return saved; }
+
+void MaintainedProduct::account(size_t flops) {
+    size_t full = 2 * A.numRows() * A.numCols() * B.numCols();
+    performed += flops;
+    if (full > flops) saved += full - flops;
+}
+
+void MaintainedProduct::recomputeAll() {
+    C = multiplier.multiplyMultiThread(A, B, numThreads);
+    account(2 * A.numRows() * A.numCols() * B.numCols());
+}
+
+void MaintainedProduct::updateRowsA(const std::vector<size_t>& rows, const Matrix& newRows) {
+    if (newRows.numRows() != rows.size() || newRows.numCols() != A.numCols()) {
+        throw std::invalid_argument("error: invalid size of the updated rows");
+    }
+
+    std::map<size_t, size_t> last = lastOccurrence(rows, A.numRows());
+    std::vector<size_t> changed;
+    for (const auto& [r, p] : last) {
+        for (size_t k = 0; k < A.numCols(); k++) {
+            A(r, k) = newRows(p, k);
+        }
+        changed.push_back(r);
+    }
+
+    size_t kdim = A.numCols();
+    size_t m = B.numCols();
+    parallelRows(changed.size(), numThreads, [&](size_t start, size_t end) {
+        for (size_t p = start; p < end; p++) {
+            size_t i = changed[p];
+            for (size_t j = 0; j < m; j++) C(i, j) = 0.0;
+            for (size_t k = 0; k < kdim; k++) {
+                double a = A(i, k);
+                for (size_t j = 0; j < m; j++) {
+                    C(i, j) += a * B(k, j);
+                }
+            }
+        }
+    });
+
+    account(2 * changed.size() * kdim * m);
+}
+
+void MaintainedProduct::updateColsB(const std::vector<size_t>& cols, const Matrix& newCols) {
+    if (newCols.numCols() != cols.size() || newCols.numRows() != B.numRows()) {
+        throw std::invalid_argument("error: invalid size of the updated columns");
+    }
+
+    std::map<size_t, size_t> last = lastOccurrence(cols, B.numCols());
+    std::vector<size_t> changed;
+    for (const auto& [c, p] : last) {
+        for (size_t k = 0; k < B.numRows(); k++) {
+            B(k, c) = newCols(k, p);
+        }
+        changed.push_back(c);
+    }
+
+    size_t kdim = A.numCols();
+    parallelRows(A.numRows(), numThreads, [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++) {
+            for (size_t c : changed) C(i, c) = 0.0;
+            for (size_t k = 0; k < kdim; k++) {
+                double a = A(i, k);
+                for (size_t c : changed) {
+                    C(i, c) += a * B(k, c);
+                }
+            }
+        }
+    });
+
+    account(2 * A.numRows() * kdim * changed.size());
+}
+
+void MaintainedProduct::updateRowsB(const std::vector<size_t>& rows, const Matrix& newRows) {
+    if (newRows.numRows() != rows.size() || newRows.numCols() != B.numCols()) {
+        throw std::invalid_argument("error: invalid size of the updated rows");
+    }
+
+    std::map<size_t, size_t> last = lastOccurrence(rows, B.numRows());
+    size_t m = B.numCols();
+    std::vector<size_t> changed;
+    Matrix delta(last.size(), m);
+    for (const auto& [r, p] : last) {
+        size_t t = changed.size();
+        for (size_t j = 0; j < m; j++) {
+            delta(t, j) = newRows(p, j) - B(r, j);
+            B(r, j) = newRows(p, j);
+        }
+        changed.push_back(r);
+    }
+
+    parallelRows(A.numRows(), numThreads, [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++) {
+            for (size_t t = 0; t < changed.size(); t++) {
+                double a = A(i, changed[t]);
+                if (a == 0.0) continue;
+                for (size_t j = 0; j < m; j++) {
+                    C(i, j) += a * delta(t, j);
+                }
+            }
+        }
+    });
+
+    account(changed.size() * m + 2 * A.numRows() * changed.size() * m);
+}
@@ -1,12 +1,12 @@
 #include "../include/Matrix.h"
 
-Matrix::Matrix(size_t r, size_t c) : rows(r), cols(c), data(r, std::vector<double>(c, 0.0)) {}
+Matrix::Matrix(size_t r, size_t c) : rows(r), cols(c), data(r * c, 0.0) {}
 
 size_t Matrix::numRows() const { return rows; }
 size_t Matrix::numCols() const { return cols; }
 
-double& Matrix::operator()(size_t i, size_t j) { return data[i][j]; }
-const double& Matrix::operator()(size_t i, size_t j) const { return data[i][j]; }
+double& Matrix::operator()(size_t i, size_t j) { return data[i * cols + j]; }
+const double& Matrix::operator()(size_t i, size_t j) const { return data[i * cols + j]; }
 
 void Matrix::fillRandom(double minVal, double maxVal) {
     std::random_device rd;
@@ -15,7 +15,24 @@ void Matrix::fillRandom(double minVal, double maxVal) {
 
     for (size_t i = 0; i < rows; i++) {
         for (size_t j = 0; j < cols; j++) {
-        data[i][j] = dist(gen);
+        data[i * cols + j] = dist(gen);
+        }
+    }
+}
+
+void Matrix::zeroRandomBlocks(size_t blockSize, double ratio) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::bernoulli_distribution zero(ratio);
+
+    for (size_t i0 = 0; i0 < rows; i0 += blockSize) {
+        for (size_t j0 = 0; j0 < cols; j0 += blockSize) {
+            if (!zero(gen)) continue;
+            for (size_t i = i0; i < std::min(i0 + blockSize, rows); i++) {
+                for (size_t j = j0; j < std::min(j0 + blockSize, cols); j++) {
+                    data[i * cols + j] = 0.0;
+                }
+            }
         }
     }
 }
@@ -27,7 +44,7 @@ void Matrix::saveToFile(const std::string& filename) const {
     out << rows << " " << cols << "\n";
     for (size_t i = 0; i < rows; i++) {
         for (size_t j = 0; j < cols; j++) {
-        out << std::fixed << std::setprecision(2) << data[i][j] << " ";
+        out << std::fixed << std::setprecision(2) << data[i * cols + j] << " ";
         }
         out << "\n";
     }
@@ -53,7 +70,7 @@ Matrix Matrix::loadFromFile(const std::string& filename) {
 void Matrix::print() const {
     for (size_t i = 0; i < rows; i++) {
         for (size_t j = 0; j < cols; j++) {
-        std::cout << std::setw(8) << std::fixed << std::setprecision(2) << data[i][j] << " ";
+        std::cout << std::setw(8) << std::fixed << std::setprecision(2) << data[i * cols + j] << " ";
         }
         std::cout << "\n";
     }
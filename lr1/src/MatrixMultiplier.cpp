@@ -1,5 +1,52 @@
 #include "MatrixMultiplier.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_INT8_KERNEL 1
+#endif
+
+static int32_t dotInt8Portable(const int8_t* a, const int8_t* b, size_t n) {
+    int32_t sum = 0;
+    for (size_t k = 0; k < n; k++) {
+        sum += int32_t(a[k]) * int32_t(b[k]);
+    }
+    return sum;
+}
+
+#ifdef HAVE_X86_INT8_KERNEL
+// vpmaddubsw needs an unsigned operand: multiply |a| by b*sign(a). Quantized values are in
+// [-127, 127], so each pair sum is at most 2*127*127 and never saturates int16.
+__attribute__((target("avx2")))
+static int32_t dotInt8Avx2(const int8_t* a, const int8_t* b, size_t n) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i acc = _mm256_setzero_si256();
+
+    size_t k = 0;
+    for (; k + 32 <= n; k += 32) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k));
+        __m256i pairs = _mm256_maddubs_epi16(_mm256_sign_epi8(va, va), _mm256_sign_epi8(vb, va));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(pairs, ones));
+    }
+
+    __m128i sum4 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum4 = _mm_hadd_epi32(sum4, sum4);
+    sum4 = _mm_hadd_epi32(sum4, sum4);
+    return _mm_cvtsi128_si32(sum4) + dotInt8Portable(a + k, b + k, n - k);
+}
+#endif
+
+using DotInt8Fn = int32_t (*)(const int8_t*, const int8_t*, size_t);
+
+static DotInt8Fn selectDotInt8() {
+#ifdef HAVE_X86_INT8_KERNEL
+    if (__builtin_cpu_supports("avx2")) return dotInt8Avx2;
+#endif
+    return dotInt8Portable;
+}
+
+static const DotInt8Fn dotInt8 = selectDotInt8();
+
 Matrix MatrixMultiplier::multiplySingleThread(const Matrix& A, const Matrix& B) {
     if (A.numCols() != B.numRows()) {
         throw std::invalid_argument("error: invalid size of the matrices");
@@ -130,6 +177,233 @@ Matrix MatrixMultiplier::multiplyAsync(const Matrix& A, const Matrix& B, size_t
     return C;
 }
 
+std::vector<bool> MatrixMultiplier::buildBlockMask(const Matrix& M) const {
+    size_t blockRows = (M.numRows() + blockSize - 1) / blockSize;
+    size_t blockCols = (M.numCols() + blockSize - 1) / blockSize;
+    std::vector<bool> mask(blockRows * blockCols, false);
+
+    for (size_t i = 0; i < M.numRows(); i++) {
+        size_t bi = i / blockSize;
+        for (size_t bj = 0; bj < blockCols; bj++) {
+            if (mask[bi * blockCols + bj]) continue;
+
+            size_t jMax = std::min((bj + 1) * blockSize, M.numCols());
+            for (size_t j = bj * blockSize; j < jMax; j++) {
+                if (M(i, j) != 0.0) {
+                    mask[bi * blockCols + bj] = true;
+                    break;
+                }
+            }
+        }
+    }
+    return mask;
+}
+
+Matrix MatrixMultiplier::multiplyBlockSparse(const Matrix& A, const Matrix& B, size_t numThreads,
+                                             BlockSparseStats* stats) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("error: invalid size of the matrices");
+    }
+
+    Matrix C(A.numRows(), B.numCols());
+    size_t block = this->blockSize;
+
+    size_t n = A.numRows();
+    size_t m = B.numCols();
+    size_t kdim = A.numCols();
+    size_t blocksI = (n + block - 1) / block;
+    size_t blocksJ = (m + block - 1) / block;
+    size_t blocksK = (kdim + block - 1) / block;
+
+    std::vector<bool> maskA = buildBlockMask(A);
+    std::vector<bool> maskB = buildBlockMask(B);
+
+    // nonzero tiles in each block-row of B
+    std::vector<size_t> nonzeroB(blocksK, 0);
+    for (size_t bk = 0; bk < blocksK; bk++) {
+        for (size_t bj = 0; bj < blocksJ; bj++) {
+            if (maskB[bk * blocksJ + bj]) nonzeroB[bk]++;
+        }
+    }
+
+    // tile products left in each block-row of C after skipping empty (i,k) and (k,j) pairs
+    std::vector<size_t> work(blocksI, 0);
+    size_t totalWork = 0;
+    for (size_t bi = 0; bi < blocksI; bi++) {
+        for (size_t bk = 0; bk < blocksK; bk++) {
+            if (maskA[bi * blocksK + bk]) work[bi] += nonzeroB[bk];
+        }
+        totalWork += work[bi];
+    }
+
+    if (stats) {
+        stats->totalTileProducts = blocksI * blocksJ * blocksK;
+        stats->computedTileProducts = totalWork;
+    }
+
+    auto worker = [&](size_t biStart, size_t biEnd) {
+        for (size_t bi = biStart; bi < biEnd; bi++) {
+            if (work[bi] == 0) continue;
+            size_t i0 = bi * block;
+            size_t iMax = std::min(i0 + block, n);
+
+            for (size_t bj = 0; bj < blocksJ; bj++) {
+                size_t j0 = bj * block;
+                size_t jMax = std::min(j0 + block, m);
+
+                for (size_t bk = 0; bk < blocksK; bk++) {
+                    if (!maskA[bi * blocksK + bk] || !maskB[bk * blocksJ + bj]) continue;
+                    size_t k0 = bk * block;
+                    size_t kMax = std::min(k0 + block, kdim);
+
+                    for (size_t i = i0; i < iMax; i++) {
+                        for (size_t k = k0; k < kMax; k++) {
+                            for (size_t j = j0; j < jMax; j++) {
+                                C(i, j) += A(i, k) * B(k, j);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // split block-rows by remaining work so every thread gets about totalWork / numThreads products
+    std::vector<std::thread> threads;
+    size_t biStart = 0;
+    size_t done = 0;
+    for (size_t t = 0; t < numThreads && biStart < blocksI; t++) {
+        size_t target = totalWork * (t + 1) / numThreads;
+        size_t biEnd = biStart;
+        while (biEnd < blocksI && (biEnd == biStart || done + work[biEnd] <= target)) {
+            done += work[biEnd];
+            biEnd++;
+        }
+        if (t + 1 == numThreads) biEnd = blocksI;
+        threads.emplace_back(worker, biStart, biEnd);
+        biStart = biEnd;
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    return C;
+}
+
+void MatrixMultiplier::multiplyFused(const Matrix& A, const Matrix& B, Matrix& C,
+                                     const Epilogue& epilogue, size_t numThreads) {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("error: invalid size of the matrices");
+    }
+    if (C.numRows() != A.numRows() || C.numCols() != B.numCols()) {
+        throw std::invalid_argument("error: invalid size of the output matrix");
+    }
+    if ((!epilogue.rowBias.empty() && epilogue.rowBias.size() != C.numRows()) ||
+        (!epilogue.colBias.empty() && epilogue.colBias.size() != C.numCols())) {
+        throw std::invalid_argument("error: invalid size of the bias vector");
+    }
+
+    size_t block = this->blockSize;
+
+    auto worker = [&](size_t iStart, size_t iEnd) {
+        size_t m = B.numCols();
+        size_t kdim = A.numCols();
+        std::vector<double> tile(block * block);
+
+        for (size_t i0 = iStart; i0 < iEnd; i0 += block) {
+            for (size_t j0 = 0; j0 < m; j0 += block) {
+                size_t iMax = std::min(i0 + block, iEnd);
+                size_t jMax = std::min(j0 + block, m);
+                std::fill(tile.begin(), tile.end(), 0.0);
+
+                for (size_t k0 = 0; k0 < kdim; k0 += block) {
+                    size_t kMax = std::min(k0 + block, kdim);
+
+                    for (size_t i = i0; i < iMax; i++) {
+                        double* out = &tile[(i - i0) * block];
+                        for (size_t k = k0; k < kMax; k++) {
+                            for (size_t j = j0; j < jMax; j++) {
+                                out[j - j0] += A(i, k) * B(k, j);
+                            }
+                        }
+                    }
+                }
+
+                for (size_t i = i0; i < iMax; i++) {
+                    for (size_t j = j0; j < jMax; j++) {
+                        C(i, j) = epilogue.apply(tile[(i - i0) * block + (j - j0)], C(i, j), i, j);
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    size_t rowsPerThread = A.numRows() / numThreads;
+    size_t extra = A.numRows() % numThreads;
+
+    size_t rowStart = 0;
+    for (size_t t = 0; t < numThreads; t++) {
+        size_t rowEnd = rowStart + rowsPerThread + (t < extra ? 1 : 0);
+        threads.emplace_back(worker, rowStart, rowEnd);
+        rowStart = rowEnd;
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+Matrix MatrixMultiplier::multiplyQuantized(const QuantizedMatrix& A, const QuantizedMatrix& Bt,
+                                           size_t numThreads) {
+    if (A.numCols() != Bt.numCols()) {
+        throw std::invalid_argument("error: invalid size of the matrices");
+    }
+
+    Matrix C(A.numRows(), Bt.numRows());
+    size_t block = this->blockSize;
+
+    auto worker = [&](size_t iStart, size_t iEnd) {
+        size_t m = Bt.numRows();
+        size_t kdim = A.numCols();
+
+        for (size_t j0 = 0; j0 < m; j0 += block) {
+            size_t jMax = std::min(j0 + block, m);
+            for (size_t i = iStart; i < iEnd; i++) {
+                for (size_t j = j0; j < jMax; j++) {
+                    int32_t acc = dotInt8(A.row(i), Bt.row(j), kdim);
+                    C(i, j) = A.scale(i) * Bt.scale(j) * acc;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    size_t rowsPerThread = A.numRows() / numThreads;
+    size_t extra = A.numRows() % numThreads;
+
+    size_t rowStart = 0;
+    for (size_t t = 0; t < numThreads; t++) {
+        size_t rowEnd = rowStart + rowsPerThread + (t < extra ? 1 : 0);
+        threads.emplace_back(worker, rowStart, rowEnd);
+        rowStart = rowEnd;
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    return C;
+}
+
+const char* MatrixMultiplier::quantizedKernelName() {
+#ifdef HAVE_X86_INT8_KERNEL
+    if (dotInt8 == dotInt8Avx2) return "avx2";
+#endif
+    return "portable";
+}
+
 bool MatrixMultiplier::areEqual(const Matrix& A, const Matrix& B, double eps) {
     if (A.numRows() != B.numRows() || A.numCols() != B.numCols()) return false;
 
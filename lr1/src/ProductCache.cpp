@@ -0,0 +1,280 @@
+#include "../include/ProductCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+static const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static const size_t HASH_CHUNK_ROWS = 64;
+static const char CACHE_MAGIC[4] = {'M', 'M', 'P', 'C'};
+static const uint32_t CACHE_VERSION = 1;
+
+static inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static inline uint64_t read64(const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t read32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t xxhRound(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static inline uint64_t xxhMergeRound(uint64_t acc, uint64_t val) {
+    acc ^= xxhRound(0, val);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+static uint64_t xxh64(const void* input, size_t len, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(input);
+    const unsigned char* end = p + len;
+    uint64_t h;
+
+    if (len >= 32) {
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+        for (; p + 32 <= end; p += 32) {
+            v1 = xxhRound(v1, read64(p));
+            v2 = xxhRound(v2, read64(p + 8));
+            v3 = xxhRound(v3, read64(p + 16));
+            v4 = xxhRound(v4, read64(p + 24));
+        }
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxhMergeRound(h, v1);
+        h = xxhMergeRound(h, v2);
+        h = xxhMergeRound(h, v3);
+        h = xxhMergeRound(h, v4);
+    } else {
+        h = seed + PRIME64_5;
+    }
+
+    h += len;
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= xxhRound(0, read64(p));
+        h = rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (p + 4 <= end) {
+        h ^= uint64_t(read32(p)) * PRIME64_1;
+        h = rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= (*p) * PRIME64_5;
+        h = rotl64(h, 11) * PRIME64_1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+ProductCache::ProductCache(size_t byteBudget, size_t numThreads)
+    : byteBudget(byteBudget), numThreads(numThreads) {}
+
+uint64_t ProductCache::hashMatrix(const Matrix& M, size_t numThreads) {
+    size_t rows = M.numRows();
+    size_t cols = M.numCols();
+    size_t numChunks = (rows + HASH_CHUNK_ROWS - 1) / HASH_CHUNK_ROWS;
+
+    // chunk boundaries do not depend on numThreads, so the hash is stable across runs
+    std::vector<uint64_t> chunkHashes(numChunks + 2);
+    chunkHashes[0] = rows;
+    chunkHashes[1] = cols;
+
+    auto worker = [&](size_t chunkStart, size_t chunkEnd) {
+        for (size_t c = chunkStart; c < chunkEnd; c++) {
+            uint64_t h = c;
+            size_t iMax = std::min((c + 1) * HASH_CHUNK_ROWS, rows);
+            for (size_t i = c * HASH_CHUNK_ROWS; i < iMax && cols > 0; i++) {
+                h = xxh64(&M(i, 0), cols * sizeof(double), h);
+            }
+            chunkHashes[c + 2] = h;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    size_t chunksPerThread = numChunks / numThreads;
+    size_t extra = numChunks % numThreads;
+
+    size_t chunkStart = 0;
+    for (size_t t = 0; t < numThreads && chunkStart < numChunks; t++) {
+        size_t chunkEnd = chunkStart + chunksPerThread + (t < extra ? 1 : 0);
+        threads.emplace_back(worker, chunkStart, chunkEnd);
+        chunkStart = chunkEnd;
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    return xxh64(chunkHashes.data(), chunkHashes.size() * sizeof(uint64_t), 0);
+}
+
+ProductKey ProductCache::makeKey(const Matrix& A, const Matrix& B) const {
+    return {hashMatrix(A, numThreads), hashMatrix(B, numThreads), A.numRows(), B.numCols()};
+}
+
+size_t ProductCache::entryBytes(const Matrix& M) {
+    return M.numRows() * M.numCols() * sizeof(double) + sizeof(Entry);
+}
+
+Matrix ProductCache::multiply(MatrixMultiplier& multiplier, const Matrix& A, const Matrix& B) {
+    ProductKey key = makeKey(A, B);
+    Matrix C(0, 0);
+    if (lookup(key, C)) {
+        return C;
+    }
+
+    C = multiplier.multiplyMultiThread(A, B, numThreads);
+    insert(key, C);
+    return C;
+}
+
+bool ProductCache::lookup(const ProductKey& key, Matrix& result) {
+    std::lock_guard<std::mutex> lg(mtx);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        missCount++;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, it->second);
+    result = it->second->second;
+    hitCount++;
+    return true;
+}
+
+void ProductCache::insert(const ProductKey& key, const Matrix& result) {
+    std::lock_guard<std::mutex> lg(mtx);
+    insertLocked(key, result);
+}
+
+void ProductCache::insertLocked(const ProductKey& key, const Matrix& result) {
+    size_t bytes = entryBytes(result);
+    if (bytes > byteBudget) return;
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        used -= entryBytes(it->second->second);
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+    while (used + bytes > byteBudget && !entries.empty()) {
+        used -= entryBytes(entries.back().second);
+        index.erase(entries.back().first);
+        entries.pop_back();
+        evictionCount++;
+    }
+
+    entries.emplace_front(key, result);
+    index[key] = entries.begin();
+    used += bytes;
+}
+
+// Format: "MMPC", u32 version, u64 count, then per entry from least to most recently used:
+// u64 hashA, u64 hashB, u64 rows, u64 cols, rows*cols doubles in row-major order.
+void ProductCache::saveToFile(const std::string& filename) const {
+    std::lock_guard<std::mutex> lg(mtx);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("error: cannot open file to write");
+
+    uint64_t count = entries.size();
+    out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        const Matrix& M = it->second;
+        uint64_t header[4] = {it->first.hashA, it->first.hashB, M.numRows(), M.numCols()};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (size_t i = 0; i < M.numRows() && M.numCols() > 0; i++) {
+            out.write(reinterpret_cast<const char*>(&M(i, 0)), M.numCols() * sizeof(double));
+        }
+    }
+}
+
+bool ProductCache::loadFromFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t count = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 || version != CACHE_VERSION) {
+        throw std::runtime_error("error: invalid product cache file");
+    }
+
+    std::lock_guard<std::mutex> lg(mtx);
+    for (uint64_t e = 0; e < count; e++) {
+        uint64_t header[4];
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!in) break;
+
+        // rows and cols come from disk: check they fit the rest of the file before allocating
+        uint64_t rows = header[2], cols = header[3];
+        uint64_t remaining = fileSize - static_cast<uint64_t>(in.tellg());
+        if (cols != 0 && rows > remaining / sizeof(double) / cols) break;
+
+        Matrix M(rows, cols);
+        for (size_t i = 0; i < M.numRows() && M.numCols() > 0; i++) {
+            in.read(reinterpret_cast<char*>(&M(i, 0)), M.numCols() * sizeof(double));
+        }
+        if (!in) break;
+
+        insertLocked({header[0], header[1], rows, cols}, M);
+    }
+    return true;
+}
+
+size_t ProductCache::hits() const {
+    std::lock_guard<std::mutex> lg(mtx);
+    return hitCount;
+}
+
+size_t ProductCache::misses() const {
+    std::lock_guard<std::mutex> lg(mtx);
+    return missCount;
+}
+
+size_t ProductCache::evictions() const {
+    std::lock_guard<std::mutex> lg(mtx);
+    return evictionCount;
+}
+
+size_t ProductCache::bytesUsed() const {
+    std::lock_guard<std::mutex> lg(mtx);
+    return used;
+}
+
+size_t ProductCache::size() const {
+    std::lock_guard<std::mutex> lg(mtx);
+    return entries.size();
+}
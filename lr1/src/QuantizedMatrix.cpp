@@ -0,0 +1,77 @@
+#include "../include/QuantizedMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+QuantizedMatrix::QuantizedMatrix(size_t r, size_t c, QuantScaleMode mode)
+    : rows(r), cols(c), mode(mode), data(r * c, 0),
+      scales(mode == QuantScaleMode::PerRow ? r : 1, 1.0) {}
+
+size_t QuantizedMatrix::numRows() const { return rows; }
+size_t QuantizedMatrix::numCols() const { return cols; }
+QuantScaleMode QuantizedMatrix::scaleMode() const { return mode; }
+
+double QuantizedMatrix::scale(size_t i) const {
+    return mode == QuantScaleMode::PerRow ? scales[i] : scales[0];
+}
+
+const int8_t* QuantizedMatrix::row(size_t i) const { return data.data() + i * cols; }
+
+QuantizedMatrix QuantizedMatrix::quantizeRows(size_t r, size_t c, QuantScaleMode mode,
+                                              const std::vector<double>& values) {
+    QuantizedMatrix q(r, c, mode);
+
+    for (size_t s = 0; s < q.scales.size(); s++) {
+        size_t begin = mode == QuantScaleMode::PerRow ? s * c : 0;
+        size_t end = mode == QuantScaleMode::PerRow ? begin + c : r * c;
+
+        double maxAbs = 0.0;
+        for (size_t idx = begin; idx < end; idx++) {
+            maxAbs = std::max(maxAbs, std::abs(values[idx]));
+        }
+        q.scales[s] = maxAbs > 0.0 ? maxAbs / 127.0 : 1.0;
+
+        for (size_t idx = begin; idx < end; idx++) {
+            long v = std::lround(values[idx] / q.scales[s]);
+            q.data[idx] = static_cast<int8_t>(std::clamp(v, -127L, 127L));
+        }
+    }
+    return q;
+}
+
+QuantizedMatrix QuantizedMatrix::quantize(const Matrix& M, QuantScaleMode mode) {
+    std::vector<double> values(M.numRows() * M.numCols());
+    for (size_t i = 0; i < M.numRows(); i++) {
+        for (size_t j = 0; j < M.numCols(); j++) {
+            values[i * M.numCols() + j] = M(i, j);
+        }
+    }
+    return quantizeRows(M.numRows(), M.numCols(), mode, values);
+}
+
+QuantizedMatrix QuantizedMatrix::quantizeTransposed(const Matrix& M, QuantScaleMode mode) {
+    std::vector<double> values(M.numRows() * M.numCols());
+    for (size_t i = 0; i < M.numRows(); i++) {
+        for (size_t j = 0; j < M.numCols(); j++) {
+            values[j * M.numRows() + i] = M(i, j);
+        }
+    }
+    return quantizeRows(M.numCols(), M.numRows(), mode, values);
+}
+
+Matrix QuantizedMatrix::dequantize() const {
+    Matrix M(rows, cols);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            M(i, j) = scale(i) * data[i * cols + j];
+        }
+    }
+    return M;
+}
+
+QuantScaleMode QuantizedMatrix::parseMode(const std::string& name) {
+    if (name == "tensor") return QuantScaleMode::PerTensor;
+    if (name == "row") return QuantScaleMode::PerRow;
+    throw std::invalid_argument("error: unknown quantization mode '" + name + "' (expected tensor or row)");
+}
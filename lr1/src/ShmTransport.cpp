@@ -0,0 +1,148 @@
+#include "../include/ShmTransport.h"
+
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const size_t CACHE_LINE = 64;
+
+struct ShmTransport::Shared {
+    std::atomic<int> failed;
+};
+
+struct ShmTransport::Mailbox {
+    alignas(CACHE_LINE) std::atomic<uint64_t> seq;
+    alignas(CACHE_LINE) std::atomic<uint64_t> acks;
+    uint64_t count;
+
+    double* data() { return reinterpret_cast<double*>(reinterpret_cast<char*>(this) + sizeof(Mailbox)); }
+};
+
+static size_t roundUp(size_t n, size_t to) { return (n + to - 1) / to * to; }
+
+std::unique_ptr<ShmTransport> ShmTransport::launch(int numRanks, size_t capacity) {
+    if (numRanks <= 0) {
+        throw std::invalid_argument("error: number of ranks must be positive");
+    }
+
+    size_t mailboxBytes = roundUp(sizeof(Mailbox) + capacity * sizeof(double), CACHE_LINE);
+    size_t regionBytes = CACHE_LINE + mailboxBytes * numRanks * NUM_TAGS;
+    void* region = mmap(nullptr, regionBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        throw std::runtime_error("error: cannot map shared memory for transport");
+    }
+
+    new (region) Shared{{0}};
+    for (int r = 0; r < numRanks * NUM_TAGS; r++) {
+        Mailbox* box = reinterpret_cast<Mailbox*>(static_cast<char*>(region) + CACHE_LINE + r * mailboxBytes);
+        new (&box->seq) std::atomic<uint64_t>(0);
+        new (&box->acks) std::atomic<uint64_t>(0);
+        box->count = 0;
+    }
+
+    std::vector<pid_t> children;
+    for (int r = 1; r < numRanks; r++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            static_cast<Shared*>(region)->failed.store(1);
+            for (pid_t child : children) waitpid(child, nullptr, 0);
+            munmap(region, regionBytes);
+            throw std::runtime_error("error: cannot fork worker process");
+        }
+        if (pid == 0) {
+            return std::unique_ptr<ShmTransport>(new ShmTransport(region, regionBytes, r, numRanks, capacity));
+        }
+        children.push_back(pid);
+    }
+
+    std::unique_ptr<ShmTransport> root(new ShmTransport(region, regionBytes, 0, numRanks, capacity));
+    root->children = std::move(children);
+    return root;
+}
+
+ShmTransport::ShmTransport(void* region, size_t regionBytes, int rank, int numRanks, size_t capacity)
+    : region(region), regionBytes(regionBytes),
+      mailboxBytes(roundUp(sizeof(Mailbox) + capacity * sizeof(double), CACHE_LINE)),
+      rankId(rank), numRanks(numRanks), capacity(capacity),
+      sent(NUM_TAGS, 0), expectedAcks(NUM_TAGS, 0), received(numRanks * NUM_TAGS, 0) {}
+
+ShmTransport::~ShmTransport() {
+    if (rankId == 0) {
+        finish();
+        munmap(region, regionBytes);
+    }
+}
+
+int ShmTransport::rank() const { return rankId; }
+int ShmTransport::size() const { return numRanks; }
+
+ShmTransport::Mailbox* ShmTransport::mailbox(int owner, int tag) const {
+    char* base = static_cast<char*>(region) + CACHE_LINE;
+    return reinterpret_cast<Mailbox*>(base + (owner * NUM_TAGS + tag) * mailboxBytes);
+}
+
+template <typename Pred>
+void ShmTransport::waitUntil(Pred ready) const {
+    const Shared* shared = static_cast<const Shared*>(region);
+    while (!ready()) {
+        if (shared->failed.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("error: another rank failed");
+        }
+        std::this_thread::yield();
+    }
+}
+
+void ShmTransport::broadcast(std::vector<double>& data, int root, const std::vector<int>& group, int tag) {
+    if (tag < 0 || tag >= NUM_TAGS || root < 0 || root >= numRanks) {
+        throw std::invalid_argument("error: invalid broadcast root or tag");
+    }
+    if (group.size() <= 1) return;
+
+    Mailbox* box = mailbox(root, tag);
+
+    if (rankId == root) {
+        if (data.size() > capacity) {
+            throw std::invalid_argument("error: message exceeds transport capacity");
+        }
+        uint64_t owed = expectedAcks[tag];
+        waitUntil([&]() { return box->acks.load(std::memory_order_acquire) == owed; });
+
+        box->count = data.size();
+        std::memcpy(box->data(), data.data(), data.size() * sizeof(double));
+        box->seq.store(++sent[tag], std::memory_order_release);
+        expectedAcks[tag] += group.size() - 1;
+        return;
+    }
+
+    uint64_t expected = ++received[root * NUM_TAGS + tag];
+    waitUntil([&]() { return box->seq.load(std::memory_order_acquire) >= expected; });
+
+    data.resize(box->count);
+    std::memcpy(data.data(), box->data(), box->count * sizeof(double));
+    box->acks.fetch_add(1, std::memory_order_release);
+}
+
+void ShmTransport::fail() {
+    static_cast<Shared*>(region)->failed.store(1);
+}
+
+bool ShmTransport::finish(int status) {
+    if (rankId != 0) {
+        _exit(status);
+    }
+
+    bool ok = true;
+    for (pid_t child : children) {
+        int childStatus = 0;
+        if (waitpid(child, &childStatus, 0) < 0 || !WIFEXITED(childStatus) || WEXITSTATUS(childStatus) != 0) {
+            ok = false;
+        }
+    }
+    children.clear();
+    return ok;
+}
@@ -0,0 +1,111 @@
+#include "../include/StreamingMultiplier.h"
+#include "../include/BoundedQueue.h"
+
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+StreamingMultiplier::StreamingMultiplier(const Matrix& B, size_t panelRows, size_t numThreads,
+                                         size_t blockSize, size_t queueDepth)
+    : B(B), panelRows(panelRows), numThreads(numThreads), queueDepth(queueDepth), multiplier(blockSize) {
+    if (panelRows == 0 || queueDepth == 0) {
+        throw std::invalid_argument("error: panel rows and queue depth must be positive");
+    }
+}
+
+StreamStats StreamingMultiplier::run(std::istream& in, std::ostream& out) {
+    StreamStats stats;
+    auto start = Clock::now();
+
+    size_t rows, cols;
+    if (!(in >> rows >> cols)) {
+        throw std::runtime_error("error: cannot read matrix header from stream");
+    }
+    if (cols != B.numRows()) {
+        throw std::invalid_argument("error: invalid size of the matrices");
+    }
+    out << rows << " " << B.numCols() << "\n";
+
+    BoundedQueue<Matrix> inputPanels(queueDepth);
+    BoundedQueue<Matrix> outputPanels(queueDepth);
+    std::exception_ptr readError, writeError, computeError;
+
+    std::thread reader([&]() {
+        try {
+            for (size_t done = 0; done < rows;) {
+                auto t0 = Clock::now();
+                Matrix panel(std::min(panelRows, rows - done), cols);
+                for (size_t i = 0; i < panel.numRows(); i++) {
+                    for (size_t k = 0; k < cols; k++) {
+                        in >> panel(i, k);
+                    }
+                }
+                if (!in) throw std::runtime_error("error: unexpected end of matrix stream");
+                stats.readTime += secondsSince(t0);
+
+                done += panel.numRows();
+                if (!inputPanels.push(std::move(panel))) break;
+            }
+        } catch (...) {
+            readError = std::current_exception();
+        }
+        inputPanels.close();
+    });
+
+    std::thread writer([&]() {
+        try {
+            Matrix panel(0, 0);
+            while (outputPanels.pop(panel)) {
+                auto t0 = Clock::now();
+                for (size_t i = 0; i < panel.numRows(); i++) {
+                    for (size_t j = 0; j < panel.numCols(); j++) {
+                        out << std::fixed << std::setprecision(2) << panel(i, j) << " ";
+                    }
+                    out << "\n";
+                }
+                out.flush();
+                if (!out) throw std::runtime_error("error: cannot write result stream");
+                stats.writeTime += secondsSince(t0);
+            }
+        } catch (...) {
+            writeError = std::current_exception();
+            outputPanels.close();
+            inputPanels.close();
+        }
+    });
+
+    try {
+        Matrix panel(0, 0);
+        while (inputPanels.pop(panel)) {
+            auto t0 = Clock::now();
+            Matrix result = multiplier.multiplyMultiThread(panel, B, numThreads);
+            stats.computeTime += secondsSince(t0);
+
+            stats.rows += panel.numRows();
+            stats.panels++;
+            if (!outputPanels.push(std::move(result))) break;
+        }
+    } catch (...) {
+        computeError = std::current_exception();
+        inputPanels.close();
+    }
+    outputPanels.close();
+
+    reader.join();
+    writer.join();
+
+    for (auto& error : {readError, computeError, writeError}) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    stats.totalTime = secondsSince(start);
+    return stats;
+}
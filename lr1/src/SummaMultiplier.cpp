@@ -0,0 +1,144 @@
+#include "../include/SummaMultiplier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// first index of part p when n items are split into `parts` nearly equal parts
+static size_t partStart(size_t n, size_t parts, size_t p) {
+    return p * (n / parts) + std::min(p, n % parts);
+}
+
+static size_t partOwner(size_t n, size_t parts, size_t index) {
+    size_t p = 0;
+    while (partStart(n, parts, p + 1) <= index) p++;
+    return p;
+}
+
+void SummaMultiplier::gridShape(int numRanks, int& gridRows, int& gridCols) {
+    gridRows = 1;
+    for (int r = 1; r * r <= numRanks; r++) {
+        if (numRanks % r == 0) gridRows = r;
+    }
+    gridCols = numRanks / gridRows;
+}
+
+size_t SummaMultiplier::messageCapacity(const Matrix& A, const Matrix& B, int numRanks) const {
+    int gridRows, gridCols;
+    gridShape(numRanks, gridRows, gridCols);
+    size_t maxRows = (A.numRows() + gridRows - 1) / gridRows;
+    size_t maxCols = (B.numCols() + gridCols - 1) / gridCols;
+    return std::max({maxRows * panelWidth, panelWidth * maxCols, maxRows * maxCols + 2});
+}
+
+Matrix SummaMultiplier::multiply(const Matrix& A, const Matrix& B, Transport& transport,
+                                 std::vector<SummaRankStats>& stats) const {
+    if (A.numCols() != B.numRows()) {
+        throw std::invalid_argument("error: invalid size of the matrices");
+    }
+    if (panelWidth == 0) {
+        throw std::invalid_argument("error: panel width must be positive");
+    }
+
+    int numRanks = transport.size();
+    int me = transport.rank();
+    int gridRows, gridCols;
+    gridShape(numRanks, gridRows, gridCols);
+    int pi = me / gridCols;
+    int pj = me % gridCols;
+
+    size_t n = A.numRows();
+    size_t kdim = A.numCols();
+    size_t m = B.numCols();
+    size_t r0 = partStart(n, gridRows, pi), rows = partStart(n, gridRows, pi + 1) - r0;
+    size_t c0 = partStart(m, gridCols, pj), cols = partStart(m, gridCols, pj + 1) - c0;
+
+    std::vector<int> rowGroup, colGroup;
+    for (int q = 0; q < gridCols; q++) rowGroup.push_back(pi * gridCols + q);
+    for (int q = 0; q < gridRows; q++) colGroup.push_back(q * gridCols + pj);
+
+    // A is split by columns over the process columns and B by rows over the process rows,
+    // so each k-panel is cut at both sets of boundaries and has exactly one owner of each
+    std::vector<double> local(rows * cols, 0.0);
+    std::vector<double> aPanel, bPanel;
+    SummaRankStats mine;
+
+    for (size_t k0 = 0; k0 < kdim;) {
+        size_t ownerA = partOwner(kdim, gridCols, k0);
+        size_t ownerB = partOwner(kdim, gridRows, k0);
+        size_t k1 = std::min({k0 + panelWidth, partStart(kdim, gridCols, ownerA + 1),
+                              partStart(kdim, gridRows, ownerB + 1)});
+        size_t w = k1 - k0;
+
+        auto t0 = Clock::now();
+        if (size_t(pj) == ownerA) {
+            aPanel.resize(rows * w);
+            for (size_t i = 0; i < rows; i++) {
+                for (size_t k = 0; k < w; k++) aPanel[i * w + k] = A(r0 + i, k0 + k);
+            }
+        }
+        transport.broadcast(aPanel, pi * gridCols + ownerA, rowGroup, 0);
+
+        if (size_t(pi) == ownerB) {
+            bPanel.resize(w * cols);
+            for (size_t k = 0; k < w; k++) {
+                for (size_t j = 0; j < cols; j++) bPanel[k * cols + j] = B(k0 + k, c0 + j);
+            }
+        }
+        transport.broadcast(bPanel, ownerB * gridCols + pj, colGroup, 1);
+        mine.commTime += secondsSince(t0);
+
+        t0 = Clock::now();
+        for (size_t i = 0; i < rows; i++) {
+            double* out = &local[i * cols];
+            for (size_t k = 0; k < w; k++) {
+                double a = aPanel[i * w + k];
+                const double* b = &bPanel[k * cols];
+                for (size_t j = 0; j < cols; j++) out[j] += a * b[j];
+            }
+        }
+        mine.computeTime += secondsSince(t0);
+
+        k0 = k1;
+    }
+
+    if (me != 0) {
+        local.push_back(mine.computeTime);
+        local.push_back(mine.commTime);
+        transport.broadcast(local, me, {0, me}, 2);
+        return Matrix(0, 0);
+    }
+
+    Matrix C(n, m);
+    stats.assign(numRanks, SummaRankStats());
+    stats[0] = mine;
+
+    for (int r = 0; r < numRanks; r++) {
+        std::vector<double> block;
+        if (r == 0) {
+            block = std::move(local);
+        } else {
+            transport.broadcast(block, r, {0, r}, 2);
+            stats[r].commTime = block.back();
+            block.pop_back();
+            stats[r].computeTime = block.back();
+            block.pop_back();
+        }
+
+        size_t br0 = partStart(n, gridRows, r / gridCols);
+        size_t bRows = partStart(n, gridRows, r / gridCols + 1) - br0;
+        size_t bc0 = partStart(m, gridCols, r % gridCols);
+        size_t bCols = partStart(m, gridCols, r % gridCols + 1) - bc0;
+        for (size_t i = 0; i < bRows; i++) {
+            for (size_t j = 0; j < bCols; j++) C(br0 + i, bc0 + j) = block[i * bCols + j];
+        }
+    }
+
+    return C;
+}
@@ -2,8 +2,14 @@
 #include "../include/MatrixMultiplier.h"
 #include "../include/Timer.h"
 #include "../include/options.h"
+#include "../include/MaintainedProduct.h"
+#include "../include/ProductCache.h"
+#include "../include/StreamingMultiplier.h"
+#include "../include/ShmTransport.h"
+#include "../include/SummaMultiplier.h"
 
 #include <fstream>
+#include <cmath>
 
 #define MAX_PRINT_MATRIX_SIZE 10
 
@@ -17,12 +23,188 @@ void printMatrixInfo(const Matrix &m, std::string name, bool debug) {
 
 }
 
+void printQuantizationError(const Matrix& exact, const Matrix& approx) {
+    double maxAbs = 0.0, diffNorm = 0.0, exactNorm = 0.0;
+    for (size_t i = 0; i < exact.numRows(); i++) {
+        for (size_t j = 0; j < exact.numCols(); j++) {
+            double diff = approx(i, j) - exact(i, j);
+            maxAbs = std::max(maxAbs, std::abs(diff));
+            diffNorm += diff * diff;
+            exactNorm += exact(i, j) * exact(i, j);
+        }
+    }
+    double relative = exactNorm > 0.0 ? std::sqrt(diffNorm / exactNorm) : std::sqrt(diffNorm);
+    std::cout << "Int8 error vs double: max abs " << maxAbs << ", relative Frobenius " << relative << "\n";
+}
+
+std::vector<double> randomVector(size_t n, double minVal, double maxVal) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> dist(minVal, maxVal);
+
+    std::vector<double> v(n);
+    for (auto& x : v) x = dist(gen);
+    return v;
+}
+
+std::vector<size_t> randomIndices(size_t count, size_t limit) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<size_t> dist(0, limit - 1);
+
+    std::vector<size_t> v(count);
+    for (auto& x : v) x = dist(gen);
+    return v;
+}
+
+// Opens a results CSV for appending. The header is written only when the file is new or
+// empty; an existing file with a different header is refused rather than mixing column layouts.
+bool openCsv(const std::string& path, const std::string& header, std::ofstream& csv) {
+    std::ifstream existing(path);
+    std::string firstLine;
+    if (existing && std::getline(existing, firstLine) && firstLine != header) {
+        std::cerr << "Error: " << path << " has header '" << firstLine << "', expected '" << header
+                  << "'; use a new CSV file\n";
+        return false;
+    }
+    existing.close();
+
+    csv.open(path, std::ios::app);
+    if (!csv) {
+        std::cerr << "Error: cannot open CSV file for writing\n";
+        return false;
+    }
+    if (firstLine.empty()) {
+        csv << header << "\n";
+    }
+    return true;
+}
+
+int runStreaming(const Options& opts) {
+    Matrix B = opts.fileB.empty() ? Matrix(opts.rows, opts.cols) : Matrix::loadFromFile(opts.fileB);
+    if (opts.fileB.empty()) B.fillRandom();
+
+    size_t numThreads = opts.threads > 0 ? opts.threads : std::thread::hardware_concurrency();
+    StreamingMultiplier streaming(B, opts.panelRows, numThreads, opts.blockSize);
+
+    std::ifstream inFile;
+    if (opts.stream != "-") {
+        inFile.open(opts.stream);
+        if (!inFile) throw std::runtime_error("error: cannot open file to read");
+    }
+    std::ofstream outFile;
+    if (!opts.output.empty()) {
+        outFile.open(opts.output);
+        if (!outFile) throw std::runtime_error("error: cannot open file to write");
+    }
+
+    StreamStats stats = streaming.run(opts.stream == "-" ? std::cin : inFile,
+                                      opts.output.empty() ? std::cout : outFile);
+
+    std::cerr << "Streamed " << stats.rows << " rows in " << stats.panels << " panels of up to "
+              << opts.panelRows << " rows (" << numThreads << " threads): " << stats.totalTime << " sec\n";
+    std::cerr << "Stage busy time: read " << stats.readTime << " sec, compute " << stats.computeTime
+              << " sec, write " << stats.writeTime << " sec\n";
+    if (opts.hugePages) {
+        std::cerr << HugePages::report() << "\n";
+    }
+    return 0;
+}
+
+struct SweepResult {
+    size_t threads;
+    double multi, async, sparse;
+};
+
+int runSweep(const Options& opts) {
+    MatrixMultiplier multiplier(opts.blockSize);
+    std::vector<size_t> sizes = opts.sizes.empty() ? std::vector<size_t>{opts.rows} : opts.sizes;
+    std::vector<size_t> threadList = opts.threadList.empty()
+        ? std::vector<size_t>{std::thread::hardware_concurrency()} : opts.threadList;
+    size_t repeats = opts.measureTime ? opts.repeats : 1;
+    bool equal = true;
+
+    std::ofstream csv;
+    if (!opts.csv.empty()) {
+        if (!openCsv(opts.csv, "size,threads,single,multi,async,blocksparse,speedup,efficiency", csv)) {
+            return 1;
+        }
+    }
+
+    for (size_t n : sizes) {
+        Matrix A(n, n), B(n, n);
+        A.fillRandom();
+        B.fillRandom();
+        if (opts.zeroBlocks > 0.0) {
+            A.zeroRandomBlocks(opts.blockSize, opts.zeroBlocks);
+            B.zeroRandomBlocks(opts.blockSize, opts.zeroBlocks);
+        }
+
+        Matrix C_single(n, n);
+        double timeSingle = Timer::measureAverageTime([&]() {
+            C_single = multiplier.multiplySingleThread(A, B);
+        }, repeats);
+
+        std::vector<SweepResult> results;
+        for (size_t t : threadList) {
+            Matrix C(n, n);
+            // warm-up: faults in output pages and caches before timing this configuration
+            C = multiplier.multiplyMultiThread(A, B, t);
+            equal &= MatrixMultiplier::areEqual(C_single, C);
+
+            SweepResult r;
+            r.threads = t;
+            r.multi = Timer::measureAverageTime([&]() { C = multiplier.multiplyMultiThread(A, B, t); }, repeats);
+            r.async = Timer::measureAverageTime([&]() { C = multiplier.multiplyAsync(A, B, t); }, repeats);
+            equal &= MatrixMultiplier::areEqual(C_single, C);
+            r.sparse = Timer::measureAverageTime([&]() { C = multiplier.multiplyBlockSparse(A, B, t); }, repeats);
+            equal &= MatrixMultiplier::areEqual(C_single, C);
+            results.push_back(r);
+        }
+
+        double baseline = 0.0;
+        for (const auto& r : results) {
+            if (r.threads == 1) baseline = r.multi;
+        }
+        if (baseline == 0.0) {
+            multiplier.multiplyMultiThread(A, B, 1);
+            baseline = Timer::measureAverageTime([&]() { multiplier.multiplyMultiThread(A, B, 1); }, repeats);
+        }
+
+        std::cout << "\nSize " << n << "x" << n << ", single-threaded: " << timeSingle << " sec\n";
+        std::cout << std::setw(8) << "threads" << std::setw(12) << "multi" << std::setw(12) << "async"
+                  << std::setw(12) << "blocksparse" << std::setw(10) << "speedup" << std::setw(12) << "efficiency\n";
+        for (const auto& r : results) {
+            double speedup = baseline / r.multi;
+            double efficiency = speedup / r.threads;
+            std::cout << std::setw(8) << r.threads << std::setw(12) << r.multi << std::setw(12) << r.async
+                      << std::setw(12) << r.sparse << std::setw(10) << speedup << std::setw(11) << efficiency << "\n";
+            if (csv.is_open()) {
+                csv << n << "," << r.threads << "," << timeSingle << "," << r.multi << "," << r.async << ","
+                    << r.sparse << "," << speedup << "," << efficiency << "\n";
+            }
+        }
+    }
+
+    std::cout << "\nResults match: " << (equal ? "yes" : "no") << std::endl;
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     Options opts = parseOptions(argc, argv);
     if (opts.debug) {
         std::cout << opts << "\n";
     }
 
+    HugePages::setEnabled(opts.hugePages);
+
+    if (!opts.stream.empty()) {
+        return runStreaming(opts);
+    }
+    if (opts.threadList.size() > 1 || !opts.sizes.empty()) {
+        return runSweep(opts);
+    }
+
     MatrixMultiplier multiplier(opts.blockSize);
 
     Matrix A = opts.fileA.empty() ? Matrix(opts.rows, opts.cols) : Matrix::loadFromFile(opts.fileA);
@@ -30,13 +212,18 @@ int main(int argc, char* argv[]) {
 
     if (opts.fileA.empty()) A.fillRandom();
     if (opts.fileB.empty()) B.fillRandom();
+
+    if (opts.zeroBlocks > 0.0) {
+        if (opts.fileA.empty()) A.zeroRandomBlocks(opts.blockSize, opts.zeroBlocks);
+        if (opts.fileB.empty()) B.zeroRandomBlocks(opts.blockSize, opts.zeroBlocks);
+    }
     
     printMatrixInfo(A, "A", opts.debug);
     printMatrixInfo(B, "B", opts.debug);
     
     Matrix C_single(A.numRows(), B.numCols());
 
-    double timeSingle, timeMulti, timeAsync;
+    double timeSingle, timeMulti, timeAsync, timeSparse;
 
     if (opts.measureTime) {
         timeSingle = Timer::measureAverageTime([&]() {
@@ -71,8 +258,190 @@ int main(int argc, char* argv[]) {
         C_async = multiplier.multiplyAsync(A, B, numTasks);
     }
 
+    Matrix C_sparse(A.numRows(), B.numCols());
+    BlockSparseStats sparseStats;
+
+    if (opts.measureTime) {
+        timeSparse = Timer::measureAverageTime([&]() {
+            C_sparse = multiplier.multiplyBlockSparse(A, B, numThreads, &sparseStats);
+        }, opts.repeats);
+        std::cout << "Block-sparse multiplication time (" << numThreads << " threads, "
+                  << sparseStats.computedTileProducts << "/" << sparseStats.totalTileProducts
+                  << " tile products computed): " << timeSparse << " sec\n";
+    } else {
+        C_sparse = multiplier.multiplyBlockSparse(A, B, numThreads, &sparseStats);
+    }
+
+    if (!opts.quantize.empty()) {
+        QuantScaleMode mode = QuantizedMatrix::parseMode(opts.quantize);
+        QuantizedMatrix qA = QuantizedMatrix::quantize(A, mode);
+        QuantizedMatrix qBt = QuantizedMatrix::quantizeTransposed(B, mode);
+        Matrix C_int8(A.numRows(), B.numCols());
+
+        if (opts.measureTime) {
+            double timeInt8 = Timer::measureAverageTime([&]() {
+                C_int8 = multiplier.multiplyQuantized(qA, qBt, numThreads);
+            }, opts.repeats);
+            std::cout << "Int8 multiplication time (" << numThreads << " threads, "
+                      << MatrixMultiplier::quantizedKernelName() << " kernel, per-" << opts.quantize
+                      << " scales): " << timeInt8 << " sec\n";
+        } else {
+            C_int8 = multiplier.multiplyQuantized(qA, qBt, numThreads);
+        }
+        printQuantizationError(C_single, C_int8);
+    }
+
     bool equal = MatrixMultiplier::areEqual(C_single, C_multi);
-    equal = MatrixMultiplier::areEqual(C_single, C_async);
+    equal &= MatrixMultiplier::areEqual(C_single, C_async);
+    equal &= MatrixMultiplier::areEqual(C_single, C_sparse);
+
+    if (!opts.epilogue.empty()) {
+        Epilogue epilogue;
+        epilogue.alpha = 1.5;
+        epilogue.beta = 0.5;
+        epilogue.rowBias = randomVector(A.numRows(), -10.0, 10.0);
+        epilogue.colBias = randomVector(B.numCols(), -10.0, 10.0);
+        epilogue.activation = Epilogue::parseActivation(opts.epilogue);
+        epilogue.clampMax = 1000.0;
+
+        Matrix C_init(A.numRows(), B.numCols());
+        C_init.fillRandom(-100.0, 100.0);
+        Matrix C_fused = C_init;
+        Matrix C_separate = C_init;
+
+        auto runFused = [&]() {
+            C_fused = C_init;
+            multiplier.multiplyFused(A, B, C_fused, epilogue, numThreads);
+        };
+        auto runSeparate = [&]() {
+            C_separate = C_init;
+            Matrix product = multiplier.multiplyMultiThread(A, B, numThreads);
+            epilogue.applySeparately(product, C_separate);
+        };
+
+        if (opts.measureTime) {
+            double timeFused = Timer::measureAverageTime(runFused, opts.repeats);
+            double timeSeparate = Timer::measureAverageTime(runSeparate, opts.repeats);
+            std::cout << "Fused epilogue (" << opts.epilogue << ") time: " << timeFused
+                      << " sec, separate passes: " << timeSeparate << " sec\n";
+        } else {
+            runFused();
+            runSeparate();
+        }
+        equal &= MatrixMultiplier::areEqual(C_fused, C_separate);
+    }
+
+    if (opts.updates > 0) {
+        MaintainedProduct maintained(A, B, numThreads, opts.blockSize);
+
+        std::vector<size_t> rowsA = randomIndices(opts.updates, A.numRows());
+        std::vector<size_t> colsB = randomIndices(opts.updates, B.numCols());
+        std::vector<size_t> rowsB = randomIndices(opts.updates, B.numRows());
+        Matrix newRowsA(opts.updates, A.numCols());
+        Matrix newColsB(B.numRows(), opts.updates);
+        Matrix newRowsB(opts.updates, B.numCols());
+        newRowsA.fillRandom();
+        newColsB.fillRandom();
+        newRowsB.fillRandom();
+
+        size_t flopsBefore = maintained.flopsPerformed();
+        double timeUpdate = Timer::measureAverageTime([&]() {
+            maintained.updateRowsA(rowsA, newRowsA);
+            maintained.updateColsB(colsB, newColsB);
+            maintained.updateRowsB(rowsB, newRowsB);
+        }, 1);
+        size_t flopsUpdate = maintained.flopsPerformed() - flopsBefore;
+
+        if (opts.measureTime) {
+            std::cout << "Incremental update time (" << opts.updates << " rows of A, columns of B, rows of B): "
+                      << timeUpdate << " sec\n";
+        }
+        std::cout << "Incremental update FLOPs: " << flopsUpdate << " performed, "
+                  << maintained.flopsSaved() << " saved vs full recompute\n";
+
+        Matrix C_updated = MatrixMultiplier::multiplySingleThread(maintained.left(), maintained.right());
+        equal &= MatrixMultiplier::areEqual(C_updated, maintained.result());
+    }
+
+    if (opts.cacheMb > 0) {
+        ProductCache cache(opts.cacheMb << 20, numThreads);
+        if (!opts.cacheFile.empty() && cache.loadFromFile(opts.cacheFile)) {
+            std::cout << "Loaded " << cache.size() << " cached products from " << opts.cacheFile << "\n";
+        }
+
+        Matrix C_cached(A.numRows(), B.numCols());
+        double timeHash = Timer::measureAverageTime([&]() {
+            cache.makeKey(A, B);
+        }, opts.repeats);
+        double timeFirst = Timer::measureAverageTime([&]() {
+            C_cached = cache.multiply(multiplier, A, B);
+        }, 1);
+        double timeRepeat = Timer::measureAverageTime([&]() {
+            C_cached = cache.multiply(multiplier, A, B);
+        }, opts.repeats);
+
+        if (opts.measureTime) {
+            std::cout << "Cached multiplication time: first " << timeFirst << " sec, repeated " << timeRepeat
+                      << " sec (hashing A and B: " << timeHash << " sec)\n";
+        }
+        std::cout << "Product cache: " << cache.hits() << " hits, " << cache.misses() << " misses, "
+                  << cache.evictions() << " evictions, " << cache.size() << " entries, "
+                  << cache.bytesUsed() << " bytes\n";
+        equal &= MatrixMultiplier::areEqual(C_single, C_cached);
+
+        if (!opts.cacheFile.empty()) {
+            cache.saveToFile(opts.cacheFile);
+        }
+    }
+
+    if (opts.distributed > 0) {
+        SummaMultiplier summa(opts.blockSize);
+        std::vector<SummaRankStats> rankStats;
+        Matrix C_summa(0, 0);
+
+        std::cout.flush();
+        auto transport = ShmTransport::launch(opts.distributed, summa.messageCapacity(A, B, opts.distributed));
+        if (transport->rank() != 0) {
+            int status = 0;
+            try {
+                summa.multiply(A, B, *transport, rankStats);
+            } catch (const std::exception& e) {
+                std::cerr << "Rank " << transport->rank() << ": " << e.what() << "\n";
+                transport->fail();
+                status = 1;
+            }
+            transport->finish(status);
+        }
+
+        double timeSumma = Timer::measureAverageTime([&]() {
+            try {
+                C_summa = summa.multiply(A, B, *transport, rankStats);
+            } catch (...) {
+                transport->fail();
+                throw;
+            }
+        }, 1);
+        if (!transport->finish()) {
+            std::cerr << "Error: a SUMMA worker process failed\n";
+            return 1;
+        }
+
+        int gridRows, gridCols;
+        SummaMultiplier::gridShape(opts.distributed, gridRows, gridCols);
+        if (opts.measureTime) {
+            std::cout << "SUMMA multiplication time (" << opts.distributed << " processes, "
+                      << gridRows << "x" << gridCols << " grid): " << timeSumma << " sec\n";
+        }
+        for (size_t r = 0; r < rankStats.size(); r++) {
+            std::cout << "  rank " << r << ": compute " << rankStats[r].computeTime
+                      << " sec, communication " << rankStats[r].commTime << " sec\n";
+        }
+        equal &= MatrixMultiplier::areEqual(C_single, C_summa);
+    }
+
+    if (opts.hugePages) {
+        std::cout << HugePages::report() << "\n";
+    }
 
     std::cout << "\nResults match: " << (equal ? "yes" : "no") << std::endl;
 
@@ -80,25 +449,23 @@ int main(int argc, char* argv[]) {
         if (opts.debug) {
             C_multi.saveToFile(opts.output);
             C_async.saveToFile(opts.output);
+            C_sparse.saveToFile(opts.output);
         }
         C_single.saveToFile(opts.output);
         std::cout << "Result saved to " << opts.output << "\n";
     } else {
         printMatrixInfo(C_multi, "Multi", opts.debug);
         printMatrixInfo(C_async, "Async", opts.debug);
+        printMatrixInfo(C_sparse, "BlockSparse", opts.debug);
         printMatrixInfo(C_single, "Result", opts.debug);
     }
 
     if (!opts.csv.empty() && opts.measureTime) {
-        std::ofstream csv(opts.csv, std::ios::app);
-        if (!csv) {
-            std::cerr << "Error: cannot open CSV file for writing\n";
+        std::ofstream csv;
+        if (!openCsv(opts.csv, "threads,single,multi,async,blocksparse", csv)) {
             return 1;
         }
-        if (csv.tellp() == 0) {
-            csv << "threads,single,multi,async\n";
-        }
-        csv << numThreads << "," << timeSingle << "," << timeMulti << "," << timeAsync << "\n";
+        csv << numThreads << "," << timeSingle << "," << timeMulti << "," << timeAsync << "," << timeSparse << "\n";
         if (opts.debug) {
             std::cout << "Exported timings to " << opts.csv << std::endl;
         }
@@ -1,5 +1,30 @@
 #include "../include/options.h"
 
+#include <sstream>
+#include <stdexcept>
+
+static std::string joinList(const std::vector<size_t>& list) {
+    std::string joined;
+    for (size_t v : list) {
+        joined += (joined.empty() ? "" : ",") + std::to_string(v);
+    }
+    return joined.empty() ? "<none>" : joined;
+}
+
+std::vector<size_t> parseList(const std::string& list) {
+    std::vector<size_t> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int value = std::stoi(item);
+        if (value <= 0) {
+            throw std::invalid_argument("error: list values must be positive");
+        }
+        values.push_back(value);
+    }
+    return values;
+}
+
 std::ostream& operator<<(std::ostream& os, const Options& opts) {
     os << "Options:\n";
     os << "  fileA: " << (opts.fileA.empty() ? "<none>" : opts.fileA) << "\n";
@@ -8,11 +33,22 @@ std::ostream& operator<<(std::ostream& os, const Options& opts) {
     os << "  cols: " << opts.cols << "\n";
     os << "  measureTime: " << (opts.measureTime ? "true" : "false") << "\n";
     os << "  repeats: " << opts.repeats << "\n";
-    os << "  threads: " << opts.threads << "\n";
+    os << "  threads: " << joinList(opts.threadList) << "\n";
+    os << "  sizes: " << joinList(opts.sizes) << "\n";
     os << "  output: " << (opts.output.empty() ? "<none>" : opts.output) << "\n";
     os << "  debug: " << (opts.debug ? "true" : "false") << "\n";
     os << "  csv: " << (opts.csv.empty() ? "<none>" : opts.csv) << "\n";
     os << "  blockSize: " << opts.blockSize << "\n";
+    os << "  zeroBlocks: " << opts.zeroBlocks << "\n";
+    os << "  quantize: " << (opts.quantize.empty() ? "<none>" : opts.quantize) << "\n";
+    os << "  epilogue: " << (opts.epilogue.empty() ? "<none>" : opts.epilogue) << "\n";
+    os << "  updates: " << opts.updates << "\n";
+    os << "  cacheMb: " << opts.cacheMb << "\n";
+    os << "  cacheFile: " << (opts.cacheFile.empty() ? "<none>" : opts.cacheFile) << "\n";
+    os << "  stream: " << (opts.stream.empty() ? "<none>" : opts.stream) << "\n";
+    os << "  panelRows: " << opts.panelRows << "\n";
+    os << "  distributed: " << opts.distributed << "\n";
+    os << "  hugePages: " << (opts.hugePages ? "true" : "false") << "\n";
     return os;
 }
 
@@ -30,14 +66,25 @@ Options parseOptions(int argc, char* argv[]) {
         {"repeats",    required_argument, 0, 'n'},
         {"output",     required_argument, 0, 'o'},
         {"threads",    required_argument, 0, 't'},
+        {"sizes",      required_argument, 0, 's'},
         {"debug",      no_argument,       0, 'd'},
         {"export-csv", required_argument, 0, 'e'},
         {"block-size", required_argument, 0, 'B'},
+        {"zero-blocks", required_argument, 0, 'z'},
+        {"quantize",   required_argument, 0, 'q'},
+        {"epilogue",   required_argument, 0, 'E'},
+        {"update",     required_argument, 0, 'U'},
+        {"cache-mb",   required_argument, 0, 'C'},
+        {"cache-file", required_argument, 0, 'P'},
+        {"stream",     required_argument, 0, 'S'},
+        {"panel-rows", required_argument, 0, 'R'},
+        {"distributed", required_argument, 0, 'D'},
+        {"hugepages",  no_argument,       0, 'H'},
         {"help",       no_argument,       0, 'h'},
         {0, 0, 0, 0}
     };
 
-    while ((opt = getopt_long(argc, argv, "r:c:a:b:Tn:t:o:de:B:h", longOpts, &longIndex)) != -1) {
+    while ((opt = getopt_long(argc, argv, "r:c:a:b:Tn:t:s:o:de:B:z:q:E:U:C:P:S:R:D:Hh", longOpts, &longIndex)) != -1) {
         switch (opt) {
         case 'r':
             opts.rows = std::stoi(optarg);
@@ -58,7 +105,11 @@ Options parseOptions(int argc, char* argv[]) {
             opts.repeats = std::stoi(optarg);
             break;
         case 't':
-            opts.threads = std::stoi(optarg);
+            opts.threadList = parseList(optarg);
+            opts.threads = opts.threadList.empty() ? 0 : opts.threadList[0];
+            break;
+        case 's':
+            opts.sizes = parseList(optarg);
             break;
         case 'o':
             opts.output = optarg;
@@ -72,6 +123,36 @@ Options parseOptions(int argc, char* argv[]) {
         case 'B':
             opts.blockSize = std::stoi(optarg);
             break;
+        case 'z':
+            opts.zeroBlocks = std::stod(optarg);
+            break;
+        case 'q':
+            opts.quantize = optarg;
+            break;
+        case 'E':
+            opts.epilogue = optarg;
+            break;
+        case 'U':
+            opts.updates = std::stoi(optarg);
+            break;
+        case 'C':
+            opts.cacheMb = std::stoi(optarg);
+            break;
+        case 'P':
+            opts.cacheFile = optarg;
+            break;
+        case 'S':
+            opts.stream = optarg;
+            break;
+        case 'R':
+            opts.panelRows = std::stoi(optarg);
+            break;
+        case 'D':
+            opts.distributed = std::stoi(optarg);
+            break;
+        case 'H':
+            opts.hugePages = true;
+            break;
         case 'h':
         default:
             std::cout << "Usage: ./mm [OPTIONS]\n\n";
@@ -83,12 +164,24 @@ Options parseOptions(int argc, char* argv[]) {
             std::cout << "  -b, --path-b FILE       Load matrix B from the specified file\n";
             std::cout << "  -T, --time              Measure execution time for multi-threaded and async multiplication\n";
             std::cout << "  -n, --repeats N         Number of repetitions to average timing results (default: 3)\n";
-            std::cout << "  -t, --threads N         Number of threads (tasks) to for multi-threaded (async) multiplication (default: number of hardware threads available on the system)\n";
+            std::cout << "  -t, --threads N[,N...]  Number of threads (tasks) to for multi-threaded (async) multiplication (default: number of hardware threads available on the system)\n";
+            std::cout << "  -s, --sizes N[,N...]    Sizes of square matrices for the thread sweep\n";
             std::cout << "  -o, --output FILE       Specify output file to save result\n";
             std::cout << "  -d, --debug             Enable debug mode\n";
-            std::cout << "  -e, --export-csv FILE   Export timing results to CSV file (append mode).\n";
-            std::cout << "                          Format: threads,single,multi,async\n";
+            std::cout << "  -e, --export-csv FILE   Export timing results to CSV file (append mode; a file with a different header is refused).\n";
+            std::cout << "                          Format: threads,single,multi,async,blocksparse\n";
+            std::cout << "                          Sweep format: size,threads,single,multi,async,blocksparse,speedup,efficiency\n";
             std::cout << "  -B, --block-size N      Size of block of matrix (default: 64)\n";
+            std::cout << "  -z, --zero-blocks RATIO Fraction of blocks zeroed in randomly generated matrices (default: 0)\n";
+            std::cout << "  -q, --quantize MODE     Also run the int8 multiplication with per-tensor or per-row scales (tensor|row)\n";
+            std::cout << "  -E, --epilogue ACT      Compare fused and separate C = act(1.5*A*B + 0.5*C + bias) (none|relu|clamp)\n";
+            std::cout << "  -U, --update N          Replace N random rows of A, columns of B and rows of B and update C incrementally\n";
+            std::cout << "  -C, --cache-mb N        Run the multi-threaded multiplication through a product cache of N MiB\n";
+            std::cout << "  -P, --cache-file FILE   Load the product cache from FILE if it exists and save it back on exit\n";
+            std::cout << "  -S, --stream FILE       Stream rows of A from FILE ('-' for stdin) and multiply them by a resident B\n";
+            std::cout << "  -R, --panel-rows N      Rows of A per panel in streaming mode (default: 64)\n";
+            std::cout << "  -D, --distributed N     Also run SUMMA on N local processes over shared memory\n";
+            std::cout << "  -H, --hugepages         Back matrices of 2 MiB and more with huge pages (MAP_HUGETLB, else MADV_HUGEPAGE)\n";
             std::cout << "  -h, --help              Display this help message and exit\n\n";
             std::cout << "Notes:\n";
             std::cout << "- If --path-a or --path-b are not specified, the matrices will be generated randomly.\n";
@@ -96,6 +189,18 @@ Options parseOptions(int argc, char* argv[]) {
             std::cout << "  even if --repeats is given.\n";
             std::cout << "- Matrices larger than 10x10 will not be displayed on the console, unless the --debug flag is used.\n";
             std::cout << "- You can optionally add --output FILE to save the result matrix to a file.\n";
+            std::cout << "- The block-sparse multiplication skips pairs of tiles where the A or B tile is entirely zero;\n";
+            std::cout << "  use --zero-blocks to generate block-structured inputs.\n";
+            std::cout << "- The --epilogue run uses a random initial C and random row and column biases; clamp is to [0, 1000].\n";
+            std::cout << "- In streaming mode B comes from --path-b (or is generated as rows x columns), the result goes to\n";
+            std::cout << "  --output or stdout and stage timings go to stderr; the other multiplications are skipped.\n";
+            std::cout << "- SUMMA uses the most square process grid for N and --block-size as the panel width.\n";
+            std::cout << "- With --hugepages the program reports how many bytes got each backing and the AnonHugePages total.\n";
+            std::cout << "- Several thread counts or --sizes run a sweep in one process: inputs and the single-threaded\n";
+            std::cout << "  baseline are computed once per size, every configuration gets an untimed warm-up run, and\n";
+            std::cout << "  speedup and efficiency are relative to the 1-thread multi-threaded run.\n";
+            std::cout << "- Product cache entries are keyed by xxHash64 of the dimensions and contents of A and B.\n";
+            std::cout << "- The int8 result is approximate: its error against the single-threaded result is reported instead of \"Results match\".\n";
             exit(0);
         }
     }
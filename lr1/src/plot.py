@@ -10,6 +10,11 @@ csv_file = sys.argv[1]
 output_file = sys.argv[2] if len(sys.argv) > 2 else "performance.png"
 
 data = pd.read_csv(csv_file)
+title = "Matrix multiplication performance"
+if "size" in data.columns:
+    size = data["size"].max()
+    data = data[data["size"] == size]
+    title += f" ({size}x{size})"
 
 threads = data["threads"].tolist()
 x = list(range(len(threads)))
@@ -21,7 +26,7 @@ plt.plot(x, data["async"], marker="o", label="Async")
 
 plt.xlabel("Number of threads / tasks")
 plt.ylabel("Execution time (seconds)")
-plt.title("Matrix multiplication performance")
+plt.title(title)
 plt.legend()
 plt.grid(True)
 
@@ -0,0 +1,70 @@
+#ifndef CONTENTION_H
+#define CONTENTION_H
+
+#include <cstdint>
+#include <mutex>
+#include "utils.h"
+
+// Per-thread contention counters for diagnosing list throughput: lock acquisitions and wait
+// time per lock kind, validation retries, nodes traversed and failed CASes. Compiled in only
+// with -DLIST_STATS (make STATS=1); otherwise every call below is an empty inline function and
+// locking is a plain lock(). Each thread counts into its own record and folds it into a
+// process-wide total when it exits.
+class ContentionStats {
+public:
+#ifdef LIST_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    enum LockKind { LOCK_LIST, LOCK_NODE, LOCK_KINDS };
+
+    enum Counter {
+        LIST_LOCK_ACQUIRES, LIST_LOCK_CONTENDED, LIST_LOCK_WAIT_NS,
+        NODE_LOCK_ACQUIRES, NODE_LOCK_CONTENDED, NODE_LOCK_WAIT_NS,
+        VALIDATE_RETRIES, NODES_TRAVERSED, CAS_FAILURES,
+        COUNTERS
+    };
+
+    static const char* const NAMES[COUNTERS];
+
+    struct Totals {
+        uint64_t values[COUNTERS] = {};
+        uint64_t operator[](Counter c) const { return values[c]; }
+    };
+
+    static void add(Counter c, uint64_t n = 1) {
+        if constexpr (enabled) local().values[c] += n;
+    }
+
+    // locks m, timing the wait only when the first try fails so uncontended locks stay cheap
+    template <typename Mutex>
+    static std::unique_lock<Mutex> acquire(Mutex& m, LockKind kind) {
+        if constexpr (enabled) {
+            Counter base = kind == LOCK_LIST ? LIST_LOCK_ACQUIRES : NODE_LOCK_ACQUIRES;
+            Totals& mine = local();
+            ++mine.values[base];
+            if (!m.try_lock()) {
+                uint64_t start = now_ns();
+                m.lock();
+                ++mine.values[base + 1];
+                mine.values[base + 2] += now_ns() - start;
+            }
+            return std::unique_lock<Mutex>(m, std::adopt_lock);
+        } else {
+            (void)kind;
+            return std::unique_lock<Mutex>(m);
+        }
+    }
+
+    // counters of exited threads plus those of the calling thread
+    static Totals total();
+    // clears both; call while no other thread is counting
+    static void reset();
+
+private:
+    static Totals& local();
+};
+
+#endif // CONTENTION_H
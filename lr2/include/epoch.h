@@ -0,0 +1,72 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Process-wide epoch-based reclamation. Threads pin the current global epoch while they read
+// shared nodes; a node retired in epoch e is freed once the global epoch reaches e + 2, which
+// can only happen after every thread pinned in e has unpinned. Each thread keeps three retire
+// lists (one per epoch modulo 3) and frees them in batches.
+class EpochReclaimer {
+public:
+    class Guard {
+    public:
+        Guard() { EpochReclaimer::pin(); }
+        ~Guard() { EpochReclaimer::unpin(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    static const size_t BATCH_SIZE = 128;
+
+    static void pin();
+    static void unpin();
+
+    template <typename T>
+    static void retire(T* p) {
+        retire_raw(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    // tries to advance the epoch and frees what the calling thread can; returns nodes freed
+    static size_t collect();
+
+    static uint64_t epoch();
+    // retired nodes of the calling thread not yet freed
+    static size_t pending();
+    // nodes freed by all threads so far
+    static size_t freed();
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    struct Record {
+        std::atomic<uint64_t> state; // epoch << 1 | pinned
+        std::atomic<bool> in_use;
+        Record* next;
+        int nesting = 0;
+        size_t since_collect = 0;
+        std::vector<Retired> limbo[3];
+        uint64_t limbo_epoch[3] = {0, 0, 0};
+    };
+
+    static std::atomic<uint64_t> global_epoch;
+    static std::atomic<Record*> records;
+    static std::atomic<size_t> freed_count;
+
+    static Record* local();
+    static Record* acquire();
+    static void release(Record* rec);
+    static void retire_raw(void* p, void (*deleter)(void*));
+    static bool try_advance();
+    static size_t free_expired(Record* rec, uint64_t epoch);
+
+    friend struct EpochRecordHolder;
+};
+
+#endif // EPOCH_H
@@ -0,0 +1,62 @@
+#ifndef HASH_SET_H
+#define HASH_SET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "node_pool.h"
+
+// Split-ordered hash set (Shalev and Shavit, 2006). All keys live in one Harris-Michael
+// list sorted by their bit-reversed hash; bucket b points at a dummy node inside that list,
+// so doubling the table only changes the bucket count and new buckets are split off lazily
+// the first time they are used. Unlinked nodes are freed through EpochReclaimer.
+class SplitOrderedSet {
+public:
+    static const int SEGMENT_BITS = 10;
+    static const size_t SEGMENT_SIZE = size_t(1) << SEGMENT_BITS;
+    static const size_t MAX_SEGMENTS = 4096;
+    static const size_t MAX_BUCKETS = SEGMENT_SIZE * MAX_SEGMENTS;
+    // average keys per bucket before the table doubles
+    static const size_t MAX_LOAD = 2;
+
+    SplitOrderedSet();
+    ~SplitOrderedSet();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value);
+
+    size_t size() const { return count.load() > 0 ? size_t(count.load()) : 0; }
+    size_t bucket_count() const { return buckets.load(); }
+    double load_factor() const { return double(size()) / double(buckets.load()); }
+    size_t resize_count() const { return resizes.load(); }
+
+private:
+    struct Node : PooledNode {
+        uint64_t key;   // split-order key: odd for values, even for bucket dummies
+        int value;
+        std::atomic<uintptr_t> next;
+        Node(uint64_t k, int v) : key(k), value(v), next(0) {}
+    };
+
+    struct Position {
+        std::atomic<uintptr_t>* prev;
+        Node* curr;
+    };
+
+    std::atomic<std::atomic<Node*>*> segments[MAX_SEGMENTS];
+    std::atomic<size_t> buckets;
+    std::atomic<int64_t> count;   // signed: a remove may be counted before its insert
+    std::atomic<size_t> resizes;
+
+    static uint32_t hash(int value);
+    static uint64_t regular_key(uint32_t h);
+    static uint64_t dummy_key(size_t bucket);
+
+    std::atomic<Node*>& slot(size_t bucket);
+    Node* bucket_head(size_t bucket);
+    void initialize_bucket(size_t bucket);
+    bool search(Node* start, uint64_t key, Position& pos);
+};
+
+#endif // HASH_SET_H
@@ -0,0 +1,52 @@
+#ifndef HAZARD_POINTERS_H
+#define HAZARD_POINTERS_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Process-wide hazard pointer domain (Michael, 2004). A thread publishes the nodes it is
+// about to dereference; retired nodes are freed only once no thread publishes them.
+class HazardPointers {
+public:
+    static const int SLOTS = 2;
+
+    // hazard slots of the calling thread; publish with a sequentially consistent store
+    static std::atomic<void*>* slots();
+    static void protect(int slot, void* p);
+    static void clear();
+
+    template <typename T>
+    static void retire(T* p) {
+        retire_raw(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    // retired nodes of the calling thread not yet freed
+    static size_t pending();
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    struct Record {
+        std::atomic<void*> hazards[SLOTS];
+        std::atomic<bool> active;
+        Record* next;
+        std::vector<Retired> retired;
+    };
+
+    static std::atomic<Record*> records;
+    static std::atomic<int> record_count;
+
+    static Record* local();
+    static Record* acquire();
+    static void release(Record* rec);
+    static void retire_raw(void* p, void (*deleter)(void*));
+    static void scan(Record* rec);
+
+    friend struct HazardRecordHolder;
+};
+
+#endif // HAZARD_POINTERS_H
@@ -0,0 +1,53 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Log-linear latency histogram in the style of HdrHistogram. Values below 2 * SUB_BUCKETS
+// are counted exactly; above that every power of two is split into SUB_BUCKETS linear
+// buckets, so any recorded value is reported within 1 / SUB_BUCKETS (about 3%) of itself.
+// Recording is a couple of shifts and one increment, and histograms of different threads
+// merge by adding counts.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+    // values at or above 2^MAX_MAGNITUDE ns (about 18 minutes) land in the last bucket
+    static const int MAX_MAGNITUDE = 40;
+
+    LatencyHistogram();
+
+    void record(uint64_t value) {
+        ++counts[index_of(value)];
+        ++total;
+        if (value > max_value) max_value = value;
+    }
+
+    void merge(const LatencyHistogram& other);
+    void clear();
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return max_value; }
+    // smallest recorded value v such that at least p percent of values are <= v
+    // (reported as the upper end of its bucket, capped at max())
+    uint64_t percentile(double p) const;
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t max_value;
+
+    static size_t index_of(uint64_t value) {
+        if (value < SUB_BUCKETS) return size_t(value);
+        int magnitude = 63 - __builtin_clzll(value);
+        if (magnitude >= MAX_MAGNITUDE) return bucket_count() - 1;
+        int shift = magnitude - SUB_BUCKET_BITS;
+        return size_t(shift + 1) * SUB_BUCKETS + size_t((value >> shift) - SUB_BUCKETS);
+    }
+    static uint64_t highest_in(size_t index);
+    static size_t bucket_count() { return size_t(MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKETS; }
+};
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,85 @@
+#ifndef KEY_TRAITS_H
+#define KEY_TRAITS_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+// How a list node keeps its key and how a traversal compares it with the key it is looking
+// for. A Probe is built once per operation, so per-node comparisons use whatever it caches.
+// The general case stores the key inline in the node and calls Compare.
+template <typename Key, typename Compare>
+struct KeyOps {
+    struct Stored {
+        Key key;
+        explicit Stored(const Key& k) : key(k) {}
+    };
+
+    struct Probe {
+        const Key& key;
+        explicit Probe(const Key& k) : key(k) {}
+    };
+
+    // node key orders before the probe
+    static bool less(const Stored& s, const Probe& p, const Compare& cmp) { return cmp(s.key, p.key); }
+    // probe orders before the node key; !less && !greater means equal
+    static bool greater(const Stored& s, const Probe& p, const Compare& cmp) { return cmp(p.key, s.key); }
+};
+
+// Strings cache their first eight bytes as a big-endian integer next to the string. That
+// prefix orders the same way as the strings, so most comparisons during a traversal are one
+// integer compare and never touch the characters; the full compare runs only on a tie. Keys
+// of up to 15 characters stay inline through the small-string buffer of std::string.
+template <>
+struct KeyOps<std::string, std::less<std::string>> {
+    static uint64_t prefix(const std::string& s) {
+        unsigned char bytes[8] = {};
+        std::memcpy(bytes, s.data(), s.size() < 8 ? s.size() : 8);
+        uint64_t p = 0;
+        for (unsigned char b : bytes) p = (p << 8) | b;
+        return p;
+    }
+
+    struct Stored {
+        uint64_t prefix;
+        std::string key;
+        explicit Stored(const std::string& k) : prefix(KeyOps::prefix(k)), key(k) {}
+    };
+
+    struct Probe {
+        uint64_t prefix;
+        const std::string& key;
+        explicit Probe(const std::string& k) : prefix(KeyOps::prefix(k)), key(k) {}
+    };
+
+    static bool less(const Stored& s, const Probe& p, const std::less<std::string>&) {
+        return s.prefix != p.prefix ? s.prefix < p.prefix : s.key.compare(p.key) < 0;
+    }
+    static bool greater(const Stored& s, const Probe& p, const std::less<std::string>&) {
+        return s.prefix != p.prefix ? s.prefix > p.prefix : s.key.compare(p.key) > 0;
+    }
+};
+
+// Payload of a map node. Sets use NoValue, which the node stores as an empty base, so a set
+// node is no larger than one without a payload.
+struct NoValue {};
+
+template <typename Value>
+using ValueArg = std::conditional_t<std::is_void<Value>::value, NoValue, Value>;
+
+template <typename Value>
+struct ValueSlot {
+    Value value;
+    explicit ValueSlot(const Value& v) : value(v) {}
+    const Value& payload() const { return value; }
+};
+
+template <>
+struct ValueSlot<NoValue> {
+    explicit ValueSlot(const NoValue&) {}
+    NoValue payload() const { return NoValue(); }
+};
+
+#endif // KEY_TRAITS_H
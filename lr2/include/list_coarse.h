@@ -1,25 +1,62 @@
 #ifndef LIST_COARSE_H
 #define LIST_COARSE_H
 
+#include <cstdint>
+#include <functional>
 #include <mutex>
+#include <string>
+#include <vector>
+#include "key_traits.h"
+#include "node_pool.h"
 
-class CoarseList {
+// Sorted list behind one mutex, ordered by Compare. With Value = void it is a set of keys;
+// otherwise every key carries a payload fixed at insertion. Member definitions live in
+// list_coarse.cpp, which instantiates the key types below.
+template <typename Key, typename Value = void, typename Compare = std::less<Key>>
+class BasicCoarseList {
 public:
-    CoarseList();
-    ~CoarseList();
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_arg = ValueArg<Value>;
 
-    bool insert(int value);
-    bool remove(int value);
-    bool find(int value);
+    BasicCoarseList();
+    // O(n) construction from keys in ascending order; repeated keys are kept once
+    explicit BasicCoarseList(const std::vector<Key>& sorted_keys);
+    ~BasicCoarseList();
+
+    bool insert(const Key& key) { return insert(key, value_arg()); }
+    bool insert(const Key& key, const value_arg& value);
+    bool remove(const Key& key);
+    bool find(const Key& key);
+    // copies the payload of key into out; false if key is absent
+    bool get(const Key& key, value_arg& out);
+
+    // Batches are sorted and applied in one merge-style pass under a single lock acquisition.
+    // insert_batch/remove_batch return how many keys changed the set; find_batch answers in
+    // the order of the input.
+    size_t insert_batch(const std::vector<Key>& keys);
+    size_t remove_batch(const std::vector<Key>& keys);
+    std::vector<bool> find_batch(const std::vector<Key>& keys);
 
 private:
-    struct Node {
-        int value;
+    using Ops = KeyOps<Key, Compare>;
+
+    struct Node : PooledNode, ValueSlot<value_arg> {
+        typename Ops::Stored key;
         Node* next;
-        Node(int v): value(v), next(nullptr) {}
+        Node(const Key& k, const value_arg& v): ValueSlot<value_arg>(v), key(k), next(nullptr) {}
     };
     Node* head;
     std::mutex mtx;
+    Compare cmp;
+
+    Node** locate(const typename Ops::Probe& probe, Node** from, uint64_t& steps);
 };
 
+using CoarseList = BasicCoarseList<int>;
+
+extern template class BasicCoarseList<int>;
+extern template class BasicCoarseList<int64_t>;
+extern template class BasicCoarseList<std::string, uint64_t>;
+
 #endif // LIST_COARSE_H
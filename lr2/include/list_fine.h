@@ -3,30 +3,80 @@
 
 #include <mutex>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "key_traits.h"
+#include "node_pool.h"
 
-class FineList {
+// Sorted lazy list (Heller et al., 2005), ordered by Compare. Nodes are marked before they are
+// unlinked, so find is wait-free and takes no locks; insert and remove lock pred and curr and
+// validate them. With Value = void it is a set; otherwise each key carries a payload fixed at
+// insertion. Member definitions live in list_fine.cpp, which instantiates the key types below.
+template <typename Key, typename Value = void, typename Compare = std::less<Key>>
+class BasicFineList {
 public:
-    FineList();
-    ~FineList();
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_arg = ValueArg<Value>;
 
-    bool insert(int value);
-    bool remove(int value);
-    bool find(int value) const;
+    // Epoch frees unlinked nodes through EpochReclaimer; Leak keeps them until the list is
+    // destroyed and exists to measure the cost of reclamation
+    enum class Reclamation { Epoch, Leak };
+
+    explicit BasicFineList(Reclamation reclamation = Reclamation::Epoch);
+    // O(n) construction from keys in ascending order; repeated keys are kept once
+    explicit BasicFineList(const std::vector<Key>& sorted_keys, Reclamation reclamation = Reclamation::Epoch);
+    ~BasicFineList();
+
+    bool insert(const Key& key) { return insert(key, value_arg()); }
+    bool insert(const Key& key, const value_arg& value);
+    bool remove(const Key& key);
+    bool find(const Key& key) const;
+    // copies the payload of key into out; false if key is absent
+    bool get(const Key& key, value_arg& out) const;
+
+    // Batches are sorted and applied in one pass from head. Updates walk hand-over-hand,
+    // always holding the lock of the node before the current position, so each lock is held
+    // only while the pass moves through its segment; find_batch is a single lock-free walk.
+    size_t insert_batch(const std::vector<Key>& keys);
+    size_t remove_batch(const std::vector<Key>& keys);
+    std::vector<bool> find_batch(const std::vector<Key>& keys) const;
 
 private:
-    struct Node {
-        int value;
-        Node* next;
+    using Ops = KeyOps<Key, Compare>;
+    using Probe = typename Ops::Probe;
+
+    // ordered so a node with an int key fits one 64-byte pool block
+    struct Node : PooledNode, ValueSlot<value_arg> {
+        std::atomic<Node*> next;
+        Node* leaked_next;
         std::mutex mtx;
+        typename Ops::Stored key;
         std::atomic<bool> marked;
 
-        Node(int v) : value(v), next(nullptr), mtx(), marked(false) {}
+        Node(const Key& k, const value_arg& v)
+            : ValueSlot<value_arg>(v), next(nullptr), leaked_next(nullptr), mtx(), key(k), marked(false) {}
     };
 
     Node* head;
     Node* tail;
+    Reclamation reclamation;
+    std::atomic<Node*> leaked;
+    Compare cmp;
 
+    void retire(Node* node);
+
+    void locate(const Probe& probe, Node*& pred, Node*& curr) const;
+    bool matches(Node* curr, const Probe& probe) const;
     bool validate(Node* pred, Node* curr) const;
 };
 
+using FineList = BasicFineList<int>;
+
+extern template class BasicFineList<int>;
+extern template class BasicFineList<int64_t>;
+extern template class BasicFineList<std::string, uint64_t>;
+
 #endif // LIST_FINE_H
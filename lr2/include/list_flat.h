@@ -0,0 +1,57 @@
+#ifndef LIST_FLAT_H
+#define LIST_FLAT_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "node_pool.h"
+
+// Sorted list behind one mutex with flat combining (Hendler et al., SPAA 2010). A thread posts
+// its operation in a publication slot on its own cache line; whichever thread gets the lock
+// becomes the combiner, collects every pending request, sorts them by key and applies them in
+// one pass over the list. The other threads wait on their slot instead of taking turns on the
+// mutex, so the list and the lock stay in the combiner's cache.
+class FlatCombiningList {
+public:
+    static const int MAX_SLOTS = 128;   // threads that can have an operation posted at once
+
+    FlatCombiningList();
+    ~FlatCombiningList();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value);
+
+private:
+    enum Op { OP_NONE, OP_INSERT, OP_REMOVE, OP_FIND };
+
+    struct Node : PooledNode {
+        int value;
+        Node* next;
+        Node(int v): value(v), next(nullptr) {}
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<bool> claimed{false};
+        std::atomic<int> op{OP_NONE};   // back to OP_NONE once the combiner has answered
+        int key = 0;
+        bool result = false;
+    };
+
+    struct Request {
+        int key;
+        int slot;
+    };
+
+    Node* head;
+    std::mutex mtx;
+    std::atomic<int> slot_limit;   // slots ever claimed; the combiner scans only these
+    std::vector<Request> pending;  // combiner scratch, guarded by mtx
+    Slot slots[MAX_SLOTS];
+
+    bool execute(Op op, int value);
+    int claim();
+    void combine();
+};
+
+#endif // LIST_FLAT_H
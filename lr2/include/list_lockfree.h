@@ -0,0 +1,36 @@
+#ifndef LIST_LOCKFREE_H
+#define LIST_LOCKFREE_H
+
+#include <atomic>
+#include <cstdint>
+#include "node_pool.h"
+
+// Harris-Michael sorted list: deletion marks the low bit of the victim's next pointer and
+// then unlinks it with CAS; unlinked nodes are reclaimed through hazard pointers.
+class LockFreeList {
+public:
+    LockFreeList();
+    ~LockFreeList();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value);
+
+private:
+    struct Node : PooledNode {
+        int value;
+        std::atomic<uintptr_t> next;
+        Node(int v) : value(v), next(0) {}
+    };
+
+    struct Position {
+        std::atomic<uintptr_t>* prev;
+        Node* curr;
+    };
+
+    std::atomic<uintptr_t> head;
+
+    bool search(int value, Position& pos);
+};
+
+#endif // LIST_LOCKFREE_H
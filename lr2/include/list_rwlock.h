@@ -0,0 +1,27 @@
+#ifndef LIST_RWLOCK_H
+#define LIST_RWLOCK_H
+
+#include <shared_mutex>
+#include "node_pool.h"
+
+// CoarseList behind a reader-writer lock: finds share the lock, updates take it exclusively.
+class RWCoarseList {
+public:
+    RWCoarseList();
+    ~RWCoarseList();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value);
+
+private:
+    struct Node : PooledNode {
+        int value;
+        Node* next;
+        Node(int v): value(v), next(nullptr) {}
+    };
+    Node* head;
+    std::shared_mutex mtx;
+};
+
+#endif // LIST_RWLOCK_H
@@ -0,0 +1,36 @@
+#ifndef LIST_SEQLOCK_H
+#define LIST_SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include "node_pool.h"
+
+// CoarseList with seqlock readers. Writers serialise on a mutex and make the sequence odd
+// while they change the list; finds traverse without writing any shared state and retry if
+// the sequence was odd or changed. Readers may walk nodes a writer just unlinked, so removed
+// nodes are freed through EpochReclaimer.
+class SeqlockCoarseList {
+public:
+    SeqlockCoarseList();
+    ~SeqlockCoarseList();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value);
+
+private:
+    struct Node : PooledNode {
+        const int value;
+        std::atomic<Node*> next;
+        Node(int v): value(v), next(nullptr) {}
+    };
+    std::atomic<Node*> head;
+    std::mutex mtx;
+    std::atomic<uint64_t> seq;
+
+    void write_begin();
+    void write_end();
+};
+
+#endif // LIST_SEQLOCK_H
@@ -0,0 +1,53 @@
+#ifndef LIST_SKIP_H
+#define LIST_SKIP_H
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+// Lazy skip list (Herlihy, Lev, Luchangco, Shavit, 2006). A node is in the set once it is
+// fully linked at all its levels and unmarked. find is wait-free; insert and remove lock
+// the predecessors, validate them and link or unlink every level at once. Unlinked nodes
+// are freed through EpochReclaimer.
+class SkipList {
+public:
+    static const int MAX_LEVEL = 24;
+
+    SkipList();
+    ~SkipList();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value) const;
+
+    // keys in [lo, hi] in ascending order; concurrent updates may or may not be observed
+    std::vector<int> range(int lo, int hi) const;
+
+private:
+    struct Node {
+        int value;
+        int top_level;
+        std::atomic<Node*>* next;
+        std::mutex mtx;
+        std::atomic<bool> marked;
+        std::atomic<bool> fully_linked;
+
+        Node(int v, int level)
+            : value(v), top_level(level), next(new std::atomic<Node*>[level + 1]),
+              mtx(), marked(false), fully_linked(false) {
+            for (int i = 0; i <= level; ++i) next[i].store(nullptr, std::memory_order_relaxed);
+        }
+        ~Node() { delete[] next; }
+    };
+
+    Node* head;
+    Node* tail;
+
+    static int random_level();
+    bool before(const Node* node, int value) const { return node != tail && node->value < value; }
+    bool holds(const Node* node, int value) const { return node != tail && node->value == value; }
+    int locate(int value, Node** preds, Node** succs) const;
+    static void unlock_preds(Node** preds, int highest);
+};
+
+#endif // LIST_SKIP_H
@@ -0,0 +1,68 @@
+#ifndef LIST_SNAPSHOT_H
+#define LIST_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "node_pool.h"
+
+// Lazy list (as FineList) with linearizable range queries, after Arbel-Raviv and Brown,
+// "Harnessing epoch-based reclamation for efficient range queries" (PPoPP 2018).
+//
+// Every node carries the clock value at which it was inserted and removed. A range query
+// takes a timestamp by advancing the clock and reports the keys alive at that time: the ones
+// it meets in the list plus the ones that were removed after it started, which removers push
+// onto a per-list stack before unlinking them. Updates and scans stamp each other's nodes
+// when they find them unstamped, so every operation agrees on one order. Scans take no locks
+// and never make writers wait; stacked nodes no running scan can need are retired through
+// EpochReclaimer.
+class SnapshotList {
+public:
+    static const int MAX_SCANS = 64;   // concurrent range queries per list
+
+    SnapshotList();
+    ~SnapshotList();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value);
+
+    // keys in [lo, hi] in ascending order, exactly as they were at one instant during the call
+    std::vector<int> range(int lo, int hi);
+    // every key, as of one instant; iterate the returned vector
+    std::vector<int> snapshot();
+
+private:
+    // ordered so the hot fields share the first cache line
+    struct Node : PooledNode {
+        std::atomic<Node*> next;
+        std::mutex mtx;
+        int value;
+        std::atomic<bool> marked;
+        std::atomic<bool> unlinked;
+        std::atomic<uint64_t> inserted_at;   // 0 until stamped
+        std::atomic<uint64_t> removed_at;    // 0 until stamped
+        std::atomic<Node*> removed_next;     // link in the removed stack
+
+        Node(int v) : next(nullptr), mtx(), value(v), marked(false), unlinked(false),
+                      inserted_at(0), removed_at(0), removed_next(nullptr) {}
+    };
+
+    Node* head;
+    Node* tail;
+    std::atomic<uint64_t> clock;
+    std::atomic<Node*> removed;
+    std::atomic<uint64_t> removals;
+    std::atomic<uint64_t> scans[MAX_SCANS];   // timestamps of running range queries, 0 = free
+    std::mutex trim_mtx;
+
+    uint64_t stamp(std::atomic<uint64_t>& at);
+    void locate(int value, Node*& pred, Node*& curr) const;
+    bool validate(Node* pred, Node* curr) const;
+    bool alive_at(Node* node, uint64_t ts);
+    int begin_scan(uint64_t& ts);
+    void trim();
+};
+
+#endif // LIST_SNAPSHOT_H
@@ -0,0 +1,82 @@
+#ifndef LIST_UNROLLED_H
+#define LIST_UNROLLED_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "node_pool.h"
+
+// Spinlock in one word that doubles as a version for optimistic readers: odd while a writer
+// holds it. Readers take a stable (even) version, read, and retry if it has moved.
+class VersionLock {
+public:
+    bool try_lock() {
+        uint64_t v = version.load(std::memory_order_relaxed);
+        if ((v & 1) || !version.compare_exchange_strong(v, v + 1, std::memory_order_acquire))
+            return false;
+        // keep writes made under the lock from becoming visible before the odd version,
+        // same as SeqlockCoarseList::write_begin
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+    void lock() {
+        while (!try_lock()) std::this_thread::yield();
+    }
+    void unlock() { version.fetch_add(1, std::memory_order_release); }
+
+    uint64_t read_begin() const {
+        uint64_t v;
+        while ((v = version.load(std::memory_order_acquire)) & 1) std::this_thread::yield();
+        return v;
+    }
+    bool read_validate(uint64_t v) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return version.load(std::memory_order_relaxed) == v;
+    }
+
+private:
+    std::atomic<uint64_t> version{0};
+};
+
+// Sorted unrolled list: each node holds up to CAPACITY sorted keys in two cache lines, so a
+// traversal takes one pointer hop per node rather than per key. A node owns the keys from its
+// fixed lower bound up to the next node's. Updates lock the one node that owns the key; a full
+// node splits its upper half into a new successor, and an underfull node absorbs its successor
+// when both fit comfortably, or is unlinked once empty. Finds take no locks: they read a node
+// between two matching versions of its lock. Merged-away nodes are freed through EpochReclaimer.
+class UnrolledList {
+public:
+    static const int CAPACITY = 25;                  // fills a 128-byte node
+    static const int MIN_FILL = CAPACITY / 4;        // below this a node tries to merge
+    static const int MERGE_LIMIT = CAPACITY * 3 / 4; // merged nodes leave room before splitting
+
+    UnrolledList();
+    ~UnrolledList();
+
+    bool insert(int value);
+    bool remove(int value);
+    bool find(int value);
+
+private:
+    struct Node : PooledNode {
+        std::atomic<Node*> next;
+        VersionLock lock;
+        const int low;
+        std::atomic<int> count;
+        std::atomic<bool> dead;
+        std::atomic<int> keys[CAPACITY];
+
+        explicit Node(int low) : next(nullptr), low(low), count(0), dead(false) {}
+    };
+    static_assert(sizeof(Node) <= 128, "an unrolled node should fill two cache lines");
+
+    Node* head;   // owns everything below the first split, INT_MIN included
+
+    Node* locate(int value, Node*& pred) const;
+    bool owns(Node* node, int value) const;
+    static int position(Node* node, int n, int value);
+    void split(Node* node, int value);
+    void shrink(Node* pred, Node* node);
+};
+
+#endif // LIST_UNROLLED_H
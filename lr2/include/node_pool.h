@@ -0,0 +1,47 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct PoolStats {
+    uint64_t allocations;
+    uint64_t frees;
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t reserved_bytes;   // slab memory taken from the system
+};
+
+// Process-wide pool for list nodes. Blocks are carved from cache-line-aligned slabs in size
+// classes of 16, 32 and 64 bytes and then whole cache lines, so no node straddles a line
+// and nodes of a line or more start on one. Each thread allocates from and frees into its
+// own cache, and hands surplus blocks back to a global pool in batches of BATCH so other
+// threads can reuse them. Slabs live until the process exits. When disabled, nodes go
+// straight to the system allocator and only the counters remain.
+class NodePool {
+public:
+    static const size_t CACHE_LINE = 64;
+    static const size_t NUM_CLASSES = 6;   // blocks of 16, 32, 64, 128, 192 and 256 bytes
+    static const size_t SLAB_BYTES = 64 * 1024;
+    static const size_t BATCH = 64;
+
+    // switch only while no node is alive, including nodes still waiting in a reclaimer;
+    // a block freed by the other path would corrupt the pool or the heap (asserted)
+    static void set_enabled(bool enabled);
+    static bool enabled();
+
+    static void* allocate(size_t bytes);
+    static void deallocate(void* p, size_t bytes);
+
+    // counters of exited threads plus the calling thread; others publish every BATCH events
+    static PoolStats stats();
+    static void reset_peak();
+};
+
+// Base for node structs that should be allocated from NodePool.
+struct PooledNode {
+    static void* operator new(size_t bytes) { return NodePool::allocate(bytes); }
+    static void operator delete(void* p, size_t bytes) { NodePool::deallocate(p, bytes); }
+};
+
+#endif // NODE_POOL_H
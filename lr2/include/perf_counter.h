@@ -0,0 +1,26 @@
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <cstdint>
+
+// Hardware cache-miss count of the calling thread and of every thread it starts while the
+// counter is open (perf_event_open with inherit; worker counts are added as they exit). Where
+// the counter cannot be opened (non-Linux, no PMU in a VM, perf_event_paranoid) stop()
+// returns -1.
+class CacheMissCounter {
+public:
+    CacheMissCounter();
+    ~CacheMissCounter();
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool available() const { return fd >= 0; }
+    void start();
+    // misses since start(); read after the counted threads have been joined
+    int64_t stop();
+
+private:
+    int fd;
+};
+
+#endif // PERF_COUNTER_H
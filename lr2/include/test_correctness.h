@@ -2,13 +2,27 @@
 #define TEST_CORRECTNESS_H
 
 #include "list_coarse.h"
+#include "list_rwlock.h"
+#include "list_seqlock.h"
+#include "list_flat.h"
 #include "list_fine.h"
+#include "list_unrolled.h"
+#include "list_lockfree.h"
+#include "list_skip.h"
+#include "list_snapshot.h"
+#include "hash_set.h"
+#include "epoch.h"
+#include "contention.h"
+#include "node_pool.h"
+#include "histogram.h"
 #include <cassert>
 #include <iostream>
 #include <vector>
 #include <thread>
 #include <atomic>
 #include <random>
+#include <limits>
+#include <string>
 
 class TestCorrectness {
 public:
@@ -18,13 +32,77 @@ public:
         bool all_passed = true;
         
         all_passed &= test_basic_operations<CoarseList>("CoarseList");
+        all_passed &= test_basic_operations<RWCoarseList>("RWCoarseList");
+        all_passed &= test_basic_operations<SeqlockCoarseList>("SeqlockCoarseList");
+        all_passed &= test_basic_operations<FlatCombiningList>("FlatCombiningList");
         all_passed &= test_basic_operations<FineList>("FineList");
+        all_passed &= test_basic_operations<UnrolledList>("UnrolledList");
+        all_passed &= test_basic_operations<LockFreeList>("LockFreeList");
+        all_passed &= test_basic_operations<SkipList>("SkipList");
+        all_passed &= test_basic_operations<SnapshotList>("SnapshotList");
+        all_passed &= test_basic_operations<SplitOrderedSet>("SplitOrderedSet");
         
         all_passed &= test_edge_cases<CoarseList>("CoarseList");
+        all_passed &= test_edge_cases<RWCoarseList>("RWCoarseList");
+        all_passed &= test_edge_cases<SeqlockCoarseList>("SeqlockCoarseList");
+        all_passed &= test_edge_cases<FlatCombiningList>("FlatCombiningList");
         all_passed &= test_edge_cases<FineList>("FineList");
-        
-        all_passed &= test_concurrent_inserts();
-        all_passed &= test_concurrent_mixed_operations();
+        all_passed &= test_edge_cases<UnrolledList>("UnrolledList");
+        all_passed &= test_edge_cases<LockFreeList>("LockFreeList");
+        all_passed &= test_edge_cases<SkipList>("SkipList");
+        all_passed &= test_edge_cases<SnapshotList>("SnapshotList");
+        all_passed &= test_edge_cases<SplitOrderedSet>("SplitOrderedSet");
+        
+        all_passed &= test_concurrent_inserts<RWCoarseList>("RWCoarseList");
+        all_passed &= test_concurrent_inserts<SeqlockCoarseList>("SeqlockCoarseList");
+        all_passed &= test_concurrent_inserts<FlatCombiningList>("FlatCombiningList");
+        all_passed &= test_concurrent_inserts<FineList>("FineList");
+        all_passed &= test_concurrent_inserts<UnrolledList>("UnrolledList");
+        all_passed &= test_concurrent_inserts<LockFreeList>("LockFreeList");
+        all_passed &= test_concurrent_inserts<SkipList>("SkipList");
+        all_passed &= test_concurrent_inserts<SnapshotList>("SnapshotList");
+        all_passed &= test_concurrent_inserts<SplitOrderedSet>("SplitOrderedSet");
+        all_passed &= test_concurrent_mixed_operations<RWCoarseList>("RWCoarseList");
+        all_passed &= test_concurrent_mixed_operations<SeqlockCoarseList>("SeqlockCoarseList");
+        all_passed &= test_concurrent_mixed_operations<FlatCombiningList>("FlatCombiningList");
+        all_passed &= test_concurrent_mixed_operations<FineList>("FineList");
+        all_passed &= test_concurrent_mixed_operations<UnrolledList>("UnrolledList");
+        all_passed &= test_concurrent_mixed_operations<LockFreeList>("LockFreeList");
+        all_passed &= test_concurrent_mixed_operations<SkipList>("SkipList");
+        all_passed &= test_concurrent_mixed_operations<SnapshotList>("SnapshotList");
+        all_passed &= test_concurrent_mixed_operations<SplitOrderedSet>("SplitOrderedSet");
+        all_passed &= test_concurrent_mixed_operations<FineList>("FineList (leak)", FineList::Reclamation::Leak);
+        all_passed &= test_concurrent_remove_race<RWCoarseList>("RWCoarseList");
+        all_passed &= test_concurrent_remove_race<SeqlockCoarseList>("SeqlockCoarseList");
+        all_passed &= test_concurrent_remove_race<FlatCombiningList>("FlatCombiningList");
+        all_passed &= test_concurrent_remove_race<FineList>("FineList");
+        all_passed &= test_concurrent_remove_race<UnrolledList>("UnrolledList");
+        all_passed &= test_concurrent_remove_race<LockFreeList>("LockFreeList");
+        all_passed &= test_concurrent_remove_race<SkipList>("SkipList");
+        all_passed &= test_concurrent_remove_race<SnapshotList>("SnapshotList");
+        all_passed &= test_concurrent_remove_race<SplitOrderedSet>("SplitOrderedSet");
+        
+        all_passed &= test_batch_operations<CoarseList>("CoarseList");
+        all_passed &= test_batch_operations<FineList>("FineList");
+        all_passed &= test_concurrent_batches<CoarseList>("CoarseList");
+        all_passed &= test_concurrent_batches<FineList>("FineList");
+        
+        all_passed &= test_keyed_list<BasicCoarseList<std::string, uint64_t>>("BasicCoarseList<string>");
+        all_passed &= test_keyed_list<BasicFineList<std::string, uint64_t>>("BasicFineList<string>");
+        all_passed &= test_wide_keys<BasicCoarseList<int64_t>>("BasicCoarseList<int64>");
+        all_passed &= test_wide_keys<BasicFineList<int64_t>>("BasicFineList<int64>");
+        
+        all_passed &= test_stable_reads<RWCoarseList>("RWCoarseList");
+        all_passed &= test_stable_reads<SeqlockCoarseList>("SeqlockCoarseList");
+        
+        all_passed &= test_unrolled_resizing();
+        all_passed &= test_skiplist_range();
+        all_passed &= test_snapshot_range();
+        all_passed &= test_hash_set_growth();
+        all_passed &= test_epoch_reclamation();
+        all_passed &= test_node_pool();
+        all_passed &= test_latency_histogram();
+        all_passed &= test_contention_stats();
         
         if (all_passed) {
             std::cout << "ALL TESTS PASSED\n";
@@ -52,6 +130,7 @@ private:
         
         assert(list.insert(5));
         assert(list.find(5));
+        assert(!list.insert(5));
         
         assert(list.insert(1));
         assert(list.insert(2));
@@ -91,6 +170,14 @@ private:
         assert(list.find(1000000));
         assert(list.remove(1000000));
         
+        assert(list.insert(std::numeric_limits<int>::max()));
+        assert(list.insert(std::numeric_limits<int>::min()));
+        assert(list.find(std::numeric_limits<int>::max()));
+        assert(list.find(std::numeric_limits<int>::min()));
+        assert(list.remove(std::numeric_limits<int>::max()));
+        assert(list.remove(std::numeric_limits<int>::min()));
+        assert(!list.find(std::numeric_limits<int>::max()));
+        
         for (int i = 0; i < 100; ++i) {
             assert(list.insert(i));
         }
@@ -111,10 +198,11 @@ private:
         return true;
     }
 
-    static bool test_concurrent_inserts() {
-        std::cout << "Testing concurrent inserts... ";
+    template<typename ListType>
+    static bool test_concurrent_inserts(const std::string& name) {
+        std::cout << "Testing concurrent inserts for " << name << "... ";
         
-        FineList list;
+        ListType list;
         const int thread_count = 4;
         const int operations_per_thread = 1000;
         std::atomic<int> success_count{0};
@@ -145,14 +233,22 @@ private:
             list.find(i);
         }
         
+        assert(success_count == thread_count * operations_per_thread);
+        for (int t = 0; t < thread_count; ++t) {
+            for (int i = 0; i < operations_per_thread; ++i) {
+                assert(list.find(t * 100000 + i));
+            }
+        }
+        
         std::cout << "PASSED (inserted: " << success_count << ")\n";
         return true;
     }
 
-    static bool test_concurrent_mixed_operations() {
-        std::cout << "Testing concurrent mixed operations... ";
+    template<typename ListType, typename... Args>
+    static bool test_concurrent_mixed_operations(const std::string& name, Args... args) {
+        std::cout << "Testing concurrent mixed operations for " << name << "... ";
         
-        FineList list;
+        ListType list(args...);
         const int thread_count = 4;
         const int operations_per_thread = 500;
         std::atomic<int> completed{0};
@@ -200,6 +296,591 @@ private:
         std::cout << "PASSED\n";
         return true;
     }
+
+    // every key is removed by exactly one of the threads racing for it
+    template<typename ListType>
+    static bool test_concurrent_remove_race(const std::string& name) {
+        std::cout << "Testing concurrent remove race for " << name << "... ";
+        
+        ListType list;
+        const int thread_count = 4;
+        const int keys = 2000;
+        std::atomic<int> removed{0};
+        std::atomic<bool> start{false};
+        
+        for (int i = 0; i < keys; ++i) {
+            assert(list.insert(i));
+        }
+        
+        auto worker = [&]() {
+            while (!start.load()) std::this_thread::yield();
+            
+            for (int i = 0; i < keys; ++i) {
+                if (list.remove(i)) {
+                    removed.fetch_add(1);
+                }
+            }
+        };
+        
+        std::vector<std::thread> threads;
+        for (int i = 0; i < thread_count; ++i) {
+            threads.emplace_back(worker);
+        }
+        
+        start.store(true);
+        for (auto& t : threads) {
+            t.join();
+        }
+        
+        assert(removed == keys);
+        for (int i = 0; i < keys; ++i) {
+            assert(!list.find(i));
+        }
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // batches give the same answers as one key at a time, in input order
+    template<typename ListType>
+    static bool test_batch_operations(const std::string& name) {
+        std::cout << "Testing batch operations for " << name << "... ";
+        
+        std::vector<int> sorted;
+        for (int i = 0; i < 100; i += 2) {
+            sorted.push_back(i);
+        }
+        sorted.push_back(98);
+        ListType list(sorted);
+        for (int i = 0; i < 100; ++i) {
+            assert(list.find(i) == (i % 2 == 0));
+        }
+        
+        assert(list.insert_batch({}) == 0);
+        assert(list.insert_batch({7, 3, 2, 7, 101, -5}) == 4);
+        assert(list.find(3) && list.find(7) && list.find(101) && list.find(-5));
+        
+        std::vector<int> query = {101, 3, 4, 5, -5, 3};
+        std::vector<bool> found = list.find_batch(query);
+        assert((found == std::vector<bool>{true, true, true, false, true, true}));
+        
+        assert(list.remove_batch({5, 3, 3, 101, 0}) == 3);
+        assert(!list.find(3) && !list.find(101) && !list.find(0));
+        assert(list.find(2) && list.find(7));
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // batches from several threads interleave with single-key operations without losing keys
+    template<typename ListType>
+    static bool test_concurrent_batches(const std::string& name) {
+        std::cout << "Testing concurrent batches for " << name << "... ";
+        
+        ListType list;
+        const int thread_count = 4;
+        const int batches = 20;
+        const int batch_size = 50;
+        std::atomic<bool> start{false};
+        
+        auto worker = [&](int thread_id) {
+            while (!start.load()) std::this_thread::yield();
+            
+            for (int b = 0; b < batches; ++b) {
+                std::vector<int> keys;
+                for (int i = 0; i < batch_size; ++i) {
+                    keys.push_back((b * batch_size + i) * thread_count + thread_id);
+                }
+                assert(list.insert_batch(keys) == size_t(batch_size));
+                list.insert(-1 - thread_id);
+                list.remove(-1 - thread_id);
+            }
+        };
+        
+        std::vector<std::thread> threads;
+        for (int i = 0; i < thread_count; ++i) {
+            threads.emplace_back(worker, i);
+        }
+        start.store(true);
+        for (auto& t : threads) {
+            t.join();
+        }
+        
+        std::vector<int> all;
+        for (int k = 0; k < thread_count * batches * batch_size; ++k) {
+            all.push_back(k);
+        }
+        std::vector<bool> found = list.find_batch(all);
+        for (bool f : found) {
+            assert(f);
+        }
+        assert(list.remove_batch(all) == all.size());
+        assert(!list.find(0));
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // keys nobody removes stay visible to readers while writers churn other keys
+    template<typename ListType>
+    static bool test_stable_reads(const std::string& name) {
+        std::cout << "Testing stable reads under writers for " << name << "... ";
+        
+        ListType list;
+        const int stable = 100;
+        const int reader_count = 3;
+        std::atomic<bool> stop{false};
+        std::atomic<int> misses{0};
+        
+        for (int i = 0; i < stable; ++i) {
+            assert(list.insert(i));
+        }
+        
+        std::thread writer([&]() {
+            int i = 0;
+            while (!stop.load()) {
+                int key = stable + (i++ % 200);
+                list.insert(key);
+                list.remove(key);
+            }
+        });
+        
+        std::vector<std::thread> readers;
+        for (int r = 0; r < reader_count; ++r) {
+            readers.emplace_back([&]() {
+                for (int round = 0; round < 200; ++round) {
+                    for (int i = 0; i < stable; ++i) {
+                        if (!list.find(i)) misses.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (auto& t : readers) {
+            t.join();
+        }
+        stop.store(true);
+        writer.join();
+        
+        assert(misses == 0);
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // enough keys to split nodes many times, then removals that merge and unlink them,
+    // concurrently on disjoint and shared keys
+    static bool test_unrolled_resizing() {
+        std::cout << "Testing node splits and merges for UnrolledList... ";
+        
+        UnrolledList list;
+        for (int i = 0; i < 2000; ++i) {
+            assert(list.insert((i * 7919) % 2000));
+        }
+        for (int i = 0; i < 2000; ++i) {
+            assert(list.find(i));
+        }
+        for (int i = 0; i < 2000; i += 2) {
+            assert(list.remove(i));
+        }
+        for (int i = 0; i < 2000; ++i) {
+            assert(list.find(i) == (i % 2 == 1));
+        }
+        
+        const int thread_count = 4;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&list, t]() {
+                std::mt19937 rng(t);
+                for (int round = 0; round < 3; ++round) {
+                    for (int i = 1 + 2 * t; i < 2000; i += 2 * thread_count) assert(list.remove(i));
+                    for (int i = 1 + 2 * t; i < 2000; i += 2 * thread_count) assert(list.insert(i));
+                }
+                for (int i = 0; i < 5000; ++i) {
+                    int key = 2000 + int(rng() % 300);
+                    if (rng() % 2) list.insert(key); else list.remove(key);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        for (int i = 0; i < 2000; ++i) {
+            assert(list.find(i) == (i % 2 == 1));
+        }
+        for (int i = 2000; i < 2300; ++i) list.remove(i);
+        for (int i = 1; i < 2000; i += 2) {
+            assert(list.remove(i));
+        }
+        assert(!list.find(1) && !list.find(1999));
+        assert(list.insert(std::numeric_limits<int>::min()));
+        assert(list.find(std::numeric_limits<int>::min()));
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // range scans return exactly the present keys, in order, while writers run outside the range
+    static bool test_skiplist_range() {
+        std::cout << "Testing range scan for SkipList... ";
+        
+        SkipList list;
+        for (int i = 0; i < 1000; ++i) {
+            assert(list.insert(i * 2));
+        }
+        
+        std::vector<int> keys = list.range(10, 20);
+        assert((keys == std::vector<int>{10, 12, 14, 16, 18, 20}));
+        assert(list.range(11, 11).empty());
+        assert(list.range(1999, 5000).size() == 0);
+        assert(list.range(-5, 0) == std::vector<int>{0});
+        
+        std::atomic<bool> stop{false};
+        std::thread writer([&]() {
+            int i = 0;
+            while (!stop.load()) {
+                int key = 2000 + (i++ % 500) * 2;
+                list.insert(key);
+                list.remove(key);
+            }
+        });
+        for (int round = 0; round < 200; ++round) {
+            std::vector<int> scan = list.range(0, 1999);
+            assert(scan.size() == 1000);
+            for (size_t i = 0; i < scan.size(); ++i) {
+                assert(scan[i] == int(i) * 2);
+            }
+        }
+        stop.store(true);
+        writer.join();
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // string keys keep their payloads and order by full string even when the cached
+    // eight-byte prefixes tie
+    template<typename ListType>
+    static bool test_keyed_list(const std::string& name) {
+        std::cout << "Testing string keys for " << name << "... ";
+        
+        ListType list;
+        std::vector<std::string> keys = {"", "a", "ab", std::string("ab\0", 3), "abcdefgh",
+                                         "abcdefgh1", "abcdefgh2", "abcdefghij", "b", "\xff"};
+        for (size_t i = keys.size(); i-- > 0;) {
+            assert(list.insert(keys[i], i * 10));
+        }
+        assert(!list.insert("abcdefgh1", 99));
+        
+        uint64_t payload = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            assert(list.find(keys[i]));
+            assert(list.get(keys[i], payload) && payload == i * 10);
+        }
+        assert(!list.find("abcdefgh0"));
+        assert(!list.get("abcdefgh3", payload));
+        
+        assert(list.remove("abcdefgh1"));
+        assert(!list.find("abcdefgh1"));
+        assert(list.find("abcdefgh2"));
+        
+        // batches sort with the same order
+        std::vector<bool> found = list.find_batch({"b", "abcdefgh1", "", "abcdefghij"});
+        assert((found == std::vector<bool>{true, false, true, true}));
+        assert(list.insert_batch({"abcdefgh1", "zz", "zz", "a"}) == 2);
+        assert(list.remove_batch({"zz", "abcdefgh1", "missing"}) == 2);
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // keys beyond the int range, under concurrent updates
+    template<typename ListType>
+    static bool test_wide_keys(const std::string& name) {
+        std::cout << "Testing 64-bit keys for " << name << "... ";
+        
+        ListType list;
+        const int64_t base = int64_t(1) << 40;
+        assert(list.insert(std::numeric_limits<int64_t>::min()));
+        assert(list.insert(std::numeric_limits<int64_t>::max()));
+        assert(list.insert(base));
+        assert(!list.find(base + (int64_t(1) << 32)));
+        assert(list.remove(base));
+        
+        const int thread_count = 4;
+        const int keys_per_thread = 500;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&list, t, base]() {
+                for (int i = 0; i < keys_per_thread; ++i) {
+                    int64_t key = base * (i + 1) + t;
+                    assert(list.insert(key));
+                    if (i % 2) assert(list.remove(key));
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        for (int t = 0; t < thread_count; ++t) {
+            for (int i = 0; i < keys_per_thread; ++i) {
+                assert(list.find(base * (i + 1) + t) == (i % 2 == 0));
+            }
+        }
+        assert(list.find(std::numeric_limits<int64_t>::min()));
+        assert(list.find(std::numeric_limits<int64_t>::max()));
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // a token that moves down one key at a time (insert the new key, then remove the old one)
+    // is never absent from a linearizable scan, although a scan walking upwards can pass the
+    // new key before it appears and the old one after it is gone
+    static bool test_snapshot_range() {
+        std::cout << "Testing snapshot range queries for SnapshotList... ";
+        
+        SnapshotList list;
+        for (int i = 0; i < 100; ++i) {
+            assert(list.insert(i * 3));
+        }
+        assert((list.range(10, 20) == std::vector<int>{12, 15, 18}));
+        assert(list.range(13, 14).empty());
+        assert(list.snapshot().size() == 100);
+        for (int i = 0; i < 100; ++i) {
+            assert(list.remove(i * 3));
+        }
+        assert(list.snapshot().empty());
+        
+        const int slots = 64;
+        list.insert(slots - 1);
+        std::atomic<bool> stop{false};
+        std::thread writer([&]() {
+            int token = slots - 1;
+            while (!stop.load()) {
+                int next = token == 0 ? slots - 1 : token - 1;
+                list.insert(next);
+                list.remove(token);
+                token = next;
+            }
+        });
+        std::thread noise([&]() {
+            int i = 0;
+            while (!stop.load()) {
+                int key = slots + (i++ % 100);
+                list.insert(key);
+                list.remove(key);
+            }
+        });
+        for (int round = 0; round < 20000; ++round) {
+            std::vector<int> scan = list.range(0, slots - 1);
+            assert(scan.size() == 1 || scan.size() == 2);
+            if (scan.size() == 2) {
+                assert(scan[1] - scan[0] == 1 || (scan[0] == 0 && scan[1] == slots - 1));
+            }
+        }
+        stop.store(true);
+        writer.join();
+        noise.join();
+        
+        std::vector<int> rest = list.snapshot();
+        assert(rest.size() == 1 && rest[0] < slots);
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // counters reflect the work done when compiled in and stay zero otherwise
+    static bool test_contention_stats() {
+        std::cout << "Testing contention counters (" << (ContentionStats::enabled ? "enabled" : "disabled") << ")... ";
+        
+        ContentionStats::reset();
+        CoarseList coarse;
+        FineList fine;
+        for (int i = 0; i < 100; ++i) {
+            coarse.insert(i);
+            fine.insert(i);
+        }
+        coarse.find(99);
+        fine.find(99);
+        
+        std::thread worker([&]() {
+            for (int i = 0; i < 100; ++i) fine.remove(i);
+        });
+        worker.join();
+        
+        ContentionStats::Totals totals = ContentionStats::total();
+        if (ContentionStats::enabled) {
+            assert(totals[ContentionStats::LIST_LOCK_ACQUIRES] == 101);
+            assert(totals[ContentionStats::LIST_LOCK_CONTENDED] == 0);
+            // inserts and removes each lock pred and curr; the worker's share arrives when it exits
+            assert(totals[ContentionStats::NODE_LOCK_ACQUIRES] == 400);
+            assert(totals[ContentionStats::NODES_TRAVERSED] >= 2 * 99 * 100 / 2);
+            assert(totals[ContentionStats::VALIDATE_RETRIES] == 0);
+        } else {
+            for (uint64_t v : totals.values) assert(v == 0);
+        }
+        ContentionStats::reset();
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // concurrent inserts double the table without losing keys
+    static bool test_hash_set_growth() {
+        std::cout << "Testing growth of SplitOrderedSet... ";
+        
+        SplitOrderedSet set;
+        const int thread_count = 4;
+        const int keys_per_thread = 5000;
+        
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&set, t]() {
+                for (int i = 0; i < keys_per_thread; ++i) {
+                    assert(set.insert(t * keys_per_thread + i));
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        
+        assert(set.size() == size_t(thread_count * keys_per_thread));
+        assert(set.resize_count() > 0);
+        assert(set.load_factor() <= double(SplitOrderedSet::MAX_LOAD));
+        for (int i = 0; i < thread_count * keys_per_thread; ++i) {
+            assert(set.find(i));
+        }
+        for (int i = 0; i < thread_count * keys_per_thread; i += 2) {
+            assert(set.remove(i));
+        }
+        assert(set.size() == size_t(thread_count * keys_per_thread / 2));
+        for (int i = 0; i < thread_count * keys_per_thread; ++i) {
+            assert(set.find(i) == (i % 2 == 1));
+        }
+        
+        std::cout << "PASSED (buckets: " << set.bucket_count() << ", resizes: " << set.resize_count() << ")\n";
+        return true;
+    }
+
+    // blocks never straddle a cache line, freed blocks flow between threads and counters balance
+    static bool test_node_pool() {
+        std::cout << "Testing node pool... ";
+        
+        const int blocks = 1000;
+        PoolStats before = NodePool::stats();
+        std::vector<void*> small;
+        std::vector<void*> large;
+        for (int i = 0; i < blocks; ++i) {
+            small.push_back(NodePool::allocate(24));
+            large.push_back(NodePool::allocate(64));
+        }
+        for (int i = 0; i < blocks; ++i) {
+            uintptr_t s = reinterpret_cast<uintptr_t>(small[i]);
+            assert(s % 32 == 0);
+            assert(reinterpret_cast<uintptr_t>(large[i]) % NodePool::CACHE_LINE == 0);
+        }
+        
+        // another thread frees them, so full batches reach the global pool
+        std::thread releaser([&]() {
+            for (int i = 0; i < blocks; ++i) {
+                NodePool::deallocate(small[i], 24);
+                NodePool::deallocate(large[i], 64);
+            }
+        });
+        releaser.join();
+        
+        PoolStats after = NodePool::stats();
+        assert(after.allocations - before.allocations == 2 * blocks);
+        assert(after.frees - before.frees == 2 * blocks);
+        assert(after.live_bytes == before.live_bytes);
+        
+        size_t reserved = after.reserved_bytes;
+        for (int i = 0; i < blocks; ++i) {
+            large[i] = NodePool::allocate(64);
+        }
+        assert(NodePool::stats().reserved_bytes == reserved);
+        for (int i = 0; i < blocks; ++i) {
+            NodePool::deallocate(large[i], 64);
+        }
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    // percentiles stay within one sub-bucket of the exact answer, also after a merge
+    static bool test_latency_histogram() {
+        std::cout << "Testing latency histogram... ";
+        
+        LatencyHistogram a;
+        LatencyHistogram b;
+        assert(a.percentile(50) == 0);
+        for (uint64_t v = 1; v <= 100000; ++v) {
+            (v % 2 ? a : b).record(v);
+        }
+        a.merge(b);
+        assert(a.count() == 100000);
+        assert(a.max() == 100000);
+        
+        const double error = 1.0 / double(LatencyHistogram::SUB_BUCKETS);
+        for (double p : {50.0, 90.0, 99.0, 99.9}) {
+            double exact = p / 100.0 * 100000;
+            double got = double(a.percentile(p));
+            assert(got >= exact && got <= exact * (1 + error));
+        }
+        assert(a.percentile(100) == 100000);
+        
+        LatencyHistogram small;
+        for (uint64_t v = 0; v < 2 * LatencyHistogram::SUB_BUCKETS; ++v) {
+            small.record(v);
+        }
+        assert(small.percentile(50) == LatencyHistogram::SUB_BUCKETS - 1);
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
+
+    struct Tracked {
+        static std::atomic<int>& destroyed() {
+            static std::atomic<int> count{0};
+            return count;
+        }
+        ~Tracked() { destroyed().fetch_add(1); }
+    };
+
+    // nodes retired while another thread is pinned survive until that thread unpins
+    static bool test_epoch_reclamation() {
+        std::cout << "Testing epoch reclamation... ";
+        
+        const int nodes = 10;
+        std::atomic<bool> pinned{false};
+        std::atomic<bool> release{false};
+        
+        std::thread reader([&]() {
+            EpochReclaimer::Guard guard;
+            pinned.store(true);
+            while (!release.load()) std::this_thread::yield();
+        });
+        while (!pinned.load()) std::this_thread::yield();
+        
+        for (int i = 0; i < nodes; ++i) {
+            EpochReclaimer::retire(new Tracked());
+        }
+        for (int i = 0; i < 5; ++i) {
+            EpochReclaimer::collect();
+        }
+        assert(Tracked::destroyed() == 0);
+        
+        release.store(true);
+        reader.join();
+        for (int i = 0; i < 5; ++i) {
+            EpochReclaimer::collect();
+        }
+        assert(Tracked::destroyed() == nodes);
+        
+        std::cout << "PASSED\n";
+        return true;
+    }
 };
 
 #endif
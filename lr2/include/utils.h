@@ -1,8 +1,12 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
 
 inline uint64_t now_ns() {
     return std::chrono::duration_cast<std::chrono::nanoseconds>(
@@ -10,4 +14,24 @@ inline uint64_t now_ns() {
         .count();
 }
 
+// ascending copy of a batch with repeated keys dropped
+template <typename Key, typename Compare = std::less<Key>>
+std::vector<Key> sorted_keys(const std::vector<Key>& keys, const Compare& cmp = Compare()) {
+    std::vector<Key> sorted(keys);
+    std::sort(sorted.begin(), sorted.end(), cmp);
+    sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                             [&](const Key& a, const Key& b) { return !cmp(a, b) && !cmp(b, a); }),
+                 sorted.end());
+    return sorted;
+}
+
+// indices of a batch ordered by key, for answering in input order after a sorted pass
+template <typename Key, typename Compare = std::less<Key>>
+std::vector<size_t> sorted_order(const std::vector<Key>& keys, const Compare& cmp = Compare()) {
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return cmp(keys[a], keys[b]); });
+    return order;
+}
+
 #endif // UTILS_H
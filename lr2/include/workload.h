@@ -0,0 +1,51 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+enum class KeyDistribution { Uniform, Zipf, Hotspot, Sequential };
+
+// Key distribution shared by all worker threads. Zipf and hotspot draw a rank and map it
+// through a fixed permutation of [1, key_range], so hot keys are spread over the key space
+// instead of sitting at the front of every sorted list.
+struct WorkloadSpec {
+    KeyDistribution dist = KeyDistribution::Uniform;
+    int key_range = 4000000;
+    double zipf_theta = 0.99;       // skew, in (0, 1)
+    double hot_fraction = 0.2;      // share of keys that are hot
+    double hot_probability = 0.8;   // share of operations that hit them
+    double zetan = 0;               // zeta(key_range, theta), filled by prepare()
+
+    // parses "uniform", "zipf[:theta]", "hotspot[:fraction:probability]" or "sequential"
+    bool parse(const std::string& text);
+    // precomputes what the generators need; call after key_range and the distribution are set
+    void prepare();
+    std::string describe() const;
+};
+
+// Per-thread key source; sequential gives every thread its own stripe of the key space.
+class KeyGenerator {
+public:
+    KeyGenerator(const WorkloadSpec& spec, int tid, int threads, uint32_t seed);
+
+    int next();
+
+private:
+    const WorkloadSpec& spec;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> unit;
+    std::uniform_int_distribution<int> uniform;
+    double zeta2;
+    double alpha;
+    double eta;
+    int64_t cursor;
+    int64_t stripe_begin;
+    int64_t stripe_size;
+
+    int64_t zipf_rank();
+    int scramble(int64_t rank) const;
+};
+
+#endif // WORKLOAD_H
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <algorithm>
 #include <vector>
 #include <thread>
 #include <random>
@@ -8,38 +9,212 @@
 #include <string>
 #include <chrono>
 #include <getopt.h>
+#include <map>
 #include "list_fine.h"
 #include "list_coarse.h"
+#include "list_flat.h"
+#include "list_rwlock.h"
+#include "list_seqlock.h"
+#include "list_lockfree.h"
+#include "list_unrolled.h"
+#include "list_skip.h"
+#include "list_snapshot.h"
+#include "hash_set.h"
+#include "node_pool.h"
+#include "contention.h"
+#include "perf_counter.h"
+#include "histogram.h"
+#include "workload.h"
 #include "utils.h"
 
+// Strong scaling splits a fixed amount of work over the threads; weak scaling gives every
+// thread the same amount, so total work grows with the thread count.
+enum class Scaling { Strong, Weak };
+
+// Key types of the templated lists: the workload draws int keys and maps them one-to-one
+// onto 64-bit IDs or short strings carrying a 64-bit payload.
+enum class KeyType { Int, Int64, String };
+
 struct BenchConfig {
     int threads = 1;
-    int ops_per_thread = 100000;
+    Scaling scaling = Scaling::Strong;
+    int operations = 100000;   // per run under strong scaling, per thread under weak scaling
     double p_insert = 0.1;
     double p_remove = 0.1;
     int key_range = 4000000;
+    KeyType key_type = KeyType::Int;
     int repeats = 3;
     std::string output_file = "results.csv";
     bool verbose = false;
+    bool pool = true;
+    int sample_every = 1;   // time every Nth operation; 0 disables latency recording
+    WorkloadSpec workload;
+    int prefill = 0;        // distinct keys inserted before timing starts
+    double duration = 0;    // seconds; 0 runs a fixed number of operations instead
+    std::string timeline_file = "timeline.csv";
+    int readers = -1;       // threads doing only finds, the rest only updates; -1 mixes
+    int batch = 1;          // keys per call; above 1 only lists with *_batch operations run
+    std::vector<int> batch_sizes = {1};
+    int scanners = 0;       // extra threads running range queries; above 0 only lists with range run
+    std::vector<int> scanner_counts = {0};
+    int scan_width = 1000;  // keys covered by one range query
+};
+
+// key type of a list; lists without key_type take int
+template <typename T, typename = void>
+struct list_key { using type = int; };
+
+template <typename T>
+struct list_key<T, std::void_t<typename T::key_type>> { using type = typename T::key_type; };
+
+template <typename T>
+using list_key_t = typename list_key<T>::type;
+
+// lists storing a payload with every key
+template <typename T, typename = void>
+struct has_payload : std::false_type {};
+
+template <typename T>
+struct has_payload<T, std::void_t<typename T::mapped_type>>
+    : std::integral_constant<bool, !std::is_void<typename T::mapped_type>::value> {};
+
+// lists offering insert_batch/remove_batch/find_batch
+template <typename T, typename = void>
+struct has_batch : std::false_type {};
+
+template <typename T>
+struct has_batch<T, std::void_t<decltype(std::declval<T&>().insert_batch(std::declval<const std::vector<list_key_t<T>>&>()))>>
+    : std::true_type {};
+
+// lists offering range(lo, hi)
+template <typename T, typename = void>
+struct has_range : std::false_type {};
+
+template <typename T>
+struct has_range<T, std::void_t<decltype(std::declval<T&>().range(0, 0))>> : std::true_type {};
+
+enum OpType { OP_INSERT, OP_REMOVE, OP_FIND, OP_TYPES };
+static const char* const OP_NAMES[OP_TYPES] = {"insert", "remove", "find"};
+static const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+static const char* const PERCENTILE_NAMES[] = {"p50", "p90", "p99", "p999"};
+
+const char* scaling_name(Scaling scaling) {
+    return scaling == Scaling::Strong ? "strong" : "weak";
+}
+
+const char* key_type_name(KeyType type) {
+    switch (type) {
+        case KeyType::Int64: return "int64";
+        case KeyType::String: return "string";
+        default: return "int";
+    }
+}
+
+// Maps a workload key onto Key. Multiplying by an odd constant is a bijection modulo any power
+// of two, so distinct keys stay distinct while neighbours spread over the whole key space.
+template <typename Key>
+Key make_key(int v);
+
+template <>
+int make_key<int>(int v) {
+    return v;
+}
+
+template <>
+int64_t make_key<int64_t>(int v) {
+    return int64_t(uint64_t(uint32_t(v)) * 0x9E3779B97F4A7C15ULL);
+}
+
+// twelve hex digits of the low 48 bits; short enough for the small-string buffer
+template <>
+std::string make_key<std::string>(int v) {
+    static const char DIGITS[] = "0123456789abcdef";
+    uint64_t id = uint64_t(uint32_t(v)) * 0x9E3779B97F4A7C15ULL;
+    char text[12];
+    for (int i = 11; i >= 0; --i, id >>= 4) text[i] = DIGITS[id & 15];
+    return std::string(text, sizeof(text));
+}
+
+// inserts key, with the workload key v as payload for lists that carry one
+template <typename ListType>
+bool insert_key(ListType& list, const list_key_t<ListType>& key, int v) {
+    if constexpr (has_payload<ListType>::value) {
+        return list.insert(key, typename ListType::mapped_type(v));
+    } else {
+        (void)v;
+        return list.insert(key);
+    }
+}
+
+// operations thread tid performs; strong scaling hands the remainder to the first threads
+uint64_t thread_ops(const BenchConfig& cfg, int tid) {
+    if (cfg.scaling == Scaling::Weak) return uint64_t(cfg.operations);
+    uint64_t share = uint64_t(cfg.operations) / cfg.threads;
+    return share + (uint64_t(tid) < uint64_t(cfg.operations) % cfg.threads ? 1 : 0);
+}
+
+struct RunResult {
+    double operations = 0;
+    double ops_per_sec = 0;
+    double allocs_per_sec = 0;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    double find_ops_per_sec = 0;
+    double update_ops_per_sec = 0;
+    double scans_per_sec = 0;
+    double scanned_keys_per_sec = 0;
+    ContentionStats::Totals contention;   // all zero unless built with STATS=1
+    int64_t cache_misses = -1;            // -1 where hardware counters are unavailable
+    double load_factor = -1;              // hash set only; -1 for the lists
+    double resizes = -1;
+    LatencyHistogram latency[OP_TYPES];
+    std::vector<double> timeline;   // ops/sec per second of a duration run
+};
+
+// per-thread progress, one cache line each so the sampling thread does not slow workers down
+struct alignas(64) ThreadProgress {
+    std::atomic<uint64_t> ops{0};
+    uint64_t finds = 0;
 };
 
 void print_usage(const char* prog_name) {
     std::cout << "Usage: " << prog_name << " [OPTIONS]\n"
-              << "Benchmark fine-grained vs coarse-grained linked list\n\n"
+              << "Benchmark coarse-grained, flat-combining, fine-grained, unrolled and lock-free linked lists, a skip list and a hash set\n\n"
               << "Options:\n"
               << "  -t, --threads N          Number of threads (default: 1,2,4,8)\n"
-              << "  -o, --operations N       Operations per thread (default: 100000)\n"
+              << "  -S, --scaling MODE       strong: N operations per run split over the threads;\n"
+              << "                           weak: N operations per thread (default: strong)\n"
+              << "  -o, --operations N       Operations, see --scaling (default: 100000)\n"
               << "  -i, --insert RATIO       Insert operation ratio (default: 0.1)\n"
               << "  -r, --remove RATIO       Remove operation ratio (default: 0.1)\n"
               << "  -f, --find RATIO         Find operation ratio (default: 0.8)\n"
               << "  -k, --key-range N        Key range (default: 4000000)\n"
+              << "  -K, --key-type TYPE      int, int64 or string (12 characters with a 64-bit payload);\n"
+              << "                           types other than int run only the coarse and fine lists\n"
+              << "                           (default: int)\n"
               << "  -n, --repeats N          Number of repeats for averaging (default: 3)\n"
               << "  -O, --output FILE        Output CSV file (default: results.csv)\n"
+              << "  -a, --allocator NAME     Node allocator: pool or system (default: pool)\n"
+              << "  -s, --sample N           Record latency of every Nth operation, 0 = off (default: 1)\n"
+              << "  -d, --dist NAME          Key distribution: uniform, zipf[:theta], hotspot[:frac:prob],\n"
+              << "                           sequential (default: uniform; zipf:0.99, hotspot:0.2:0.8)\n"
+              << "  -p, --prefill N          Insert N distinct keys before timing (default: 0)\n"
+              << "  -D, --duration SECONDS   Run for a fixed time instead of a fixed operation count\n"
+              << "  -T, --timeline FILE      Per-second throughput of duration runs (default: timeline.csv)\n"
+              << "  -R, --readers N          N threads only find, the others only update (default: mixed)\n"
+              << "  -b, --batch N[,N...]     Keys per call; sizes above 1 run only lists with batch\n"
+              << "                           operations (default: 1)\n"
+              << "  -c, --scanners N[,N...]  Extra threads running range queries alongside the workers;\n"
+              << "                           counts above 0 run only lists with range; 0 is always\n"
+              << "                           run first as the writer_slowdown baseline (default: 0)\n"
+              << "  -w, --scan-width N       Keys covered by one range query (default: 1000)\n"
               << "  -v, --verbose            Verbose output\n"
               << "  -h, --help               Show this help message\n"
               << "\nExamples:\n"
               << "  " << prog_name << " -t 1,4,16 -i 0.2 -r 0.2 -f 0.6\n"
-              << "  " << prog_name << " --threads=8 --operations=50000 --insert=0.05\n";
+              << "  " << prog_name << " --threads=8 --operations=50000 --insert=0.05\n"
+              << "  " << prog_name << " -t 4 -k 100000 -p 50000 -d zipf:0.9 -D 10 -R 3\n"
+              << "  " << prog_name << " -t 2 -k 100000 -p 50000 -c 0,1,2 -w 5000\n";
 }
 
 std::vector<int> parse_thread_list(const std::string& thread_str) {
@@ -60,26 +235,48 @@ BenchConfig parse_args(int argc, char** argv) {
     
     static struct option long_options[] = {
         {"threads", required_argument, 0, 't'},
+        {"scaling", required_argument, 0, 'S'},
         {"operations", required_argument, 0, 'o'},
         {"insert", required_argument, 0, 'i'},
         {"remove", required_argument, 0, 'r'},
         {"find", required_argument, 0, 'f'},
         {"key-range", required_argument, 0, 'k'},
+        {"key-type", required_argument, 0, 'K'},
         {"repeats", required_argument, 0, 'n'},
         {"output", required_argument, 0, 'O'},
+        {"allocator", required_argument, 0, 'a'},
+        {"sample", required_argument, 0, 's'},
+        {"dist", required_argument, 0, 'd'},
+        {"prefill", required_argument, 0, 'p'},
+        {"duration", required_argument, 0, 'D'},
+        {"timeline", required_argument, 0, 'T'},
+        {"readers", required_argument, 0, 'R'},
+        {"batch", required_argument, 0, 'b'},
+        {"scanners", required_argument, 0, 'c'},
+        {"scan-width", required_argument, 0, 'w'},
         {"verbose", no_argument, 0, 'v'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
     
     int c;
-    while ((c = getopt_long(argc, argv, "t:o:i:r:f:k:n:O:vh", long_options, nullptr)) != -1) {
+    while ((c = getopt_long(argc, argv, "t:S:o:i:r:f:k:K:n:O:a:s:d:p:D:T:R:b:c:w:vh", long_options, nullptr)) != -1) {
         switch (c) {
             case 't':
                 thread_str = optarg;
                 break;
+            case 'S':
+                if (std::string(optarg) == "strong") {
+                    config.scaling = Scaling::Strong;
+                } else if (std::string(optarg) == "weak") {
+                    config.scaling = Scaling::Weak;
+                } else {
+                    std::cerr << "Error: Unknown scaling mode " << optarg << "\n";
+                    exit(1);
+                }
+                break;
             case 'o':
-                config.ops_per_thread = std::stoi(optarg);
+                config.operations = std::stoi(optarg);
                 break;
             case 'i':
                 config.p_insert = std::stod(optarg);
@@ -100,12 +297,84 @@ BenchConfig parse_args(int argc, char** argv) {
             case 'k':
                 config.key_range = std::stoi(optarg);
                 break;
+            case 'K':
+                if (std::string(optarg) == "int") {
+                    config.key_type = KeyType::Int;
+                } else if (std::string(optarg) == "int64") {
+                    config.key_type = KeyType::Int64;
+                } else if (std::string(optarg) == "string") {
+                    config.key_type = KeyType::String;
+                } else {
+                    std::cerr << "Error: Unknown key type " << optarg << "\n";
+                    exit(1);
+                }
+                break;
             case 'n':
                 config.repeats = std::stoi(optarg);
                 break;
             case 'O':
                 config.output_file = optarg;
                 break;
+            case 'a':
+                {
+                std::string name = optarg;
+                if (name != "pool" && name != "system") {
+                    std::cerr << "Error: Unknown allocator " << name << "\n";
+                    exit(1);
+                }
+                config.pool = name == "pool";
+                }
+                break;
+            case 's':
+                config.sample_every = std::stoi(optarg);
+                if (config.sample_every < 0) {
+                    std::cerr << "Error: Sample interval must be >= 0\n";
+                    exit(1);
+                }
+                break;
+            case 'd':
+                if (!config.workload.parse(optarg)) {
+                    std::cerr << "Error: Unknown key distribution " << optarg << "\n";
+                    exit(1);
+                }
+                break;
+            case 'p':
+                config.prefill = std::stoi(optarg);
+                break;
+            case 'D':
+                config.duration = std::stod(optarg);
+                break;
+            case 'T':
+                config.timeline_file = optarg;
+                break;
+            case 'R':
+                config.readers = std::stoi(optarg);
+                break;
+            case 'b':
+                config.batch_sizes = parse_thread_list(optarg);
+                for (int b : config.batch_sizes) {
+                    if (b < 1) {
+                        std::cerr << "Error: Batch sizes must be >= 1\n";
+                        exit(1);
+                    }
+                }
+                break;
+            case 'c':
+                config.scanner_counts = parse_thread_list(optarg);
+                for (int n : config.scanner_counts) {
+                    if (n < 0) {
+                        std::cerr << "Error: Scanner counts must be >= 0\n";
+                        exit(1);
+                    }
+                }
+                break;
+            case 'w':
+                config.scan_width = std::stoi(optarg);
+                if (config.scan_width < 1) {
+                    std::cerr << "Error: Scan width must be >= 1\n";
+                    exit(1);
+                }
+                break;
             case 'v':
                 config.verbose = true;
                 break;
@@ -118,6 +387,17 @@ BenchConfig parse_args(int argc, char** argv) {
         }
     }
     
+    if (config.prefill < 0 || config.prefill > config.key_range) {
+        std::cerr << "Error: Prefill must be between 0 and the key range\n";
+        exit(1);
+    }
+    if (config.duration < 0) {
+        std::cerr << "Error: Duration must be >= 0\n";
+        exit(1);
+    }
+    config.workload.key_range = config.key_range;
+    config.workload.prepare();
+
     config.threads = 0;
     if (config.verbose) {
         std::cout << "Thread counts: " << thread_str << "\n";
@@ -126,47 +406,333 @@ BenchConfig parse_args(int argc, char** argv) {
     return config;
 }
 
+// structure-specific statistics recorded after each run; most lists have none
+template <typename ListType>
+void record_structure(const ListType&, RunResult&) {}
+
+void record_structure(const SplitOrderedSet& set, RunResult& result) {
+    result.load_factor = set.load_factor();
+    result.resizes = double(set.resize_count());
+}
+
+// inserts distinct uniform keys until the list holds cfg.prefill of them
+template <typename ListType>
+void prefill_list(ListType& list, const BenchConfig& cfg) {
+    std::mt19937 rng(0xF111);
+    std::uniform_int_distribution<int> val_dist(1, cfg.key_range);
+    for (int inserted = 0; inserted < cfg.prefill;) {
+        int v = val_dist(rng);
+        if (insert_key(list, make_key<list_key_t<ListType>>(v), v)) ++inserted;
+    }
+}
+
 template <typename ListType, typename... Args>
-double run_once(const BenchConfig& cfg, const std::string &label, Args&&... args) {
+RunResult run_once(const BenchConfig& cfg, const std::string &label, Args&&... args) {
     ListType list(std::forward<Args>(args)...);
+    prefill_list(list, cfg);
+    PoolStats before = NodePool::stats();
+    NodePool::reset_peak();
+    ContentionStats::reset();
+    CacheMissCounter misses;
+    misses.start();
     std::atomic<int> started{0};
+    std::atomic<bool> stop{false};
+    std::vector<ThreadProgress> progress(cfg.threads);
+    // one set per thread, merged after the run so recording never shares a cache line
+    std::vector<std::vector<LatencyHistogram>> latency(cfg.threads, std::vector<LatencyHistogram>(OP_TYPES));
+    double p_update = cfg.p_insert + cfg.p_remove;
+    double writer_insert = p_update > 0 ? cfg.p_insert / p_update : 0.5;
 
     auto worker = [&](int tid) {
+        KeyGenerator keys(cfg.workload, tid, cfg.threads, tid + 0xC0FFEE);
         std::mt19937 rng(tid + 0xC0FFEE);
-        std::uniform_int_distribution<int> val_dist(1, cfg.key_range);
         std::uniform_real_distribution<double> op_dist(0.0, 1.0);
+        std::vector<LatencyHistogram>& hist = latency[tid];
+        ThreadProgress& mine = progress[tid];
+        bool reader = cfg.readers >= 0 && tid < cfg.readers;
+        bool writer = cfg.readers >= 0 && tid >= cfg.readers;
+        int until_sample = cfg.sample_every;
+        uint64_t limit = cfg.duration > 0 ? UINT64_MAX : thread_ops(cfg, tid);
 
         started.fetch_add(1);
         while (started.load() < cfg.threads) std::this_thread::yield();
 
-        for (int i = 0; i < cfg.ops_per_thread / cfg.threads; ++i) {
+        // one key per call, or with batching one operation type per call of up to cfg.batch keys
+        uint64_t per_call = has_batch<ListType>::value ? uint64_t(std::max(1, cfg.batch)) : 1;
+        using Key = list_key_t<ListType>;
+        std::vector<Key> batch;
+        batch.reserve(per_call);
+
+        for (uint64_t i = 0; i < limit && !stop.load(std::memory_order_relaxed);) {
             double op = op_dist(rng);
-            int v = val_dist(rng);
-            if (op < cfg.p_insert) {
-                list.insert(v);
-            } else if (op < cfg.p_insert + cfg.p_remove) {
-                list.remove(v);
+            OpType type;
+            if (reader) {
+                type = OP_FIND;
+            } else if (writer) {
+                type = op < writer_insert ? OP_INSERT : OP_REMOVE;
             } else {
-                list.find(v);
+                type = op < cfg.p_insert ? OP_INSERT : op < p_update ? OP_REMOVE : OP_FIND;
+            }
+            uint64_t n = std::min(per_call, limit - i);
+            bool timed = until_sample > 0 && --until_sample == 0;
+            uint64_t start = 0;
+            // keys are built before the clock starts, so latency is the list operation alone
+            if (n == 1 && per_call == 1) {
+                int v = keys.next();
+                Key key = make_key<Key>(v);
+                if (timed) start = now_ns();
+                if (type == OP_INSERT) {
+                    insert_key(list, key, v);
+                } else if (type == OP_REMOVE) {
+                    list.remove(key);
+                } else {
+                    list.find(key);
+                }
+            } else if constexpr (has_batch<ListType>::value) {
+                batch.clear();
+                for (uint64_t k = 0; k < n; ++k) batch.push_back(make_key<Key>(keys.next()));
+                if (timed) start = now_ns();
+                if (type == OP_INSERT) {
+                    list.insert_batch(batch);
+                } else if (type == OP_REMOVE) {
+                    list.remove_batch(batch);
+                } else {
+                    list.find_batch(batch);
+                }
+            }
+            if (timed) {
+                hist[type].record(now_ns() - start);
+                until_sample = cfg.sample_every;
             }
+            if (type == OP_FIND) mine.finds += n;
+            i += n;
+            mine.ops.store(i, std::memory_order_relaxed);
         }
     };
 
+    // range queries over random windows until the workers are done; not part of ops_per_sec
+    std::atomic<bool> workers_done{false};
+    std::vector<ThreadProgress> scanned(cfg.scanners);
+    auto scanner = [&](int sid) {
+        std::mt19937 rng(sid + 0x5CA11);
+        std::uniform_int_distribution<int> lo_dist(1, std::max(1, cfg.key_range - cfg.scan_width + 1));
+        ThreadProgress& mine = scanned[sid];
+        while (started.load() < cfg.threads) std::this_thread::yield();
+        uint64_t scans = 0;
+        while (!workers_done.load(std::memory_order_relaxed)) {
+            if constexpr (has_range<ListType>::value) {
+                int lo = lo_dist(rng);
+                mine.finds += list.range(lo, lo + cfg.scan_width - 1).size();
+            }
+            mine.ops.store(++scans, std::memory_order_relaxed);
+        }
+    };
+
+    auto total_ops = [&]() {
+        uint64_t total = 0;
+        for (const ThreadProgress& p : progress) total += p.ops.load(std::memory_order_relaxed);
+        return total;
+    };
+
+    RunResult result;
     std::vector<std::thread> thr;
+    std::vector<std::thread> scan_thr;
+    for (int i = 0; i < cfg.scanners; ++i) scan_thr.emplace_back(scanner, i);
     uint64_t t0 = now_ns();
     for (int i = 0; i < cfg.threads; ++i) thr.emplace_back(worker, i);
+    if (cfg.duration > 0) {
+        uint64_t end = t0 + uint64_t(cfg.duration * 1e9);
+        uint64_t tick = t0;
+        uint64_t last_ops = 0;
+        while (tick < end) {
+            uint64_t next = std::min<uint64_t>(tick + 1000000000ULL, end);
+            uint64_t now = now_ns();
+            if (next > now) std::this_thread::sleep_for(std::chrono::nanoseconds(next - now));
+            uint64_t ops = total_ops();
+            now = now_ns();
+            result.timeline.push_back(double(ops - last_ops) / (double(now - tick) / 1e9));
+            last_ops = ops;
+            tick = now;
+        }
+        stop.store(true);
+    }
     for (auto &t : thr) t.join();
     uint64_t t1 = now_ns();
+    // worker threads fold their counters in as they exit; read them before the scanners exit so
+    // range-query traversals stay out of nodes_per_op, which divides by worker operations
+    result.contention = ContentionStats::total();
+    workers_done.store(true);
+    for (auto &t : scan_thr) t.join();
+    result.cache_misses = misses.stop();
+    record_structure(list, result);
+    PoolStats after = NodePool::stats();
     double secs = double(t1 - t0) / 1e9;
-    double total_ops = double(cfg.ops_per_thread);
-    double ops_per_sec = total_ops / secs;
+    double ops = double(total_ops());
+    double finds = 0;
+    for (const ThreadProgress& p : progress) finds += double(p.finds);
+
+    result.operations = ops;
+    result.ops_per_sec = ops / secs;
+    result.find_ops_per_sec = finds / secs;
+    result.update_ops_per_sec = (ops - finds) / secs;
+    for (const ThreadProgress& s : scanned) {
+        result.scans_per_sec += double(s.ops.load()) / secs;
+        result.scanned_keys_per_sec += double(s.finds) / secs;
+    }
+    result.allocs_per_sec = double(after.allocations - before.allocations) / secs;
+    result.live_bytes = after.live_bytes;
+    result.peak_bytes = after.peak_bytes;
+    for (int t = 0; t < cfg.threads; ++t) {
+        for (int op = 0; op < OP_TYPES; ++op) result.latency[op].merge(latency[t][op]);
+    }
     
     if (cfg.verbose) {
         std::cout << label << ": threads=" << cfg.threads
-                  << " ops=" << total_ops << " time=" << secs << "s"
-                  << " ops/s=" << ops_per_sec << std::endl;
+                  << " ops=" << ops << " time=" << secs << "s"
+                  << " ops/s=" << result.ops_per_sec
+                  << " allocs/s=" << result.allocs_per_sec
+                  << " live=" << result.live_bytes << "B peak=" << result.peak_bytes << "B";
+        if (result.cache_misses >= 0) std::cout << " cache_misses=" << result.cache_misses;
+        if (cfg.scanners > 0) std::cout << " scans/s=" << result.scans_per_sec;
+        if (result.load_factor >= 0) {
+            std::cout << " load_factor=" << result.load_factor << " resizes=" << result.resizes;
+        }
+        std::cout << std::endl;
+        for (int op = 0; op < OP_TYPES; ++op) {
+            const LatencyHistogram& h = result.latency[op];
+            if (h.count() == 0) continue;
+            std::cout << "  " << OP_NAMES[op] << " latency ns:";
+            for (int p = 0; p < 4; ++p) std::cout << " " << PERCENTILE_NAMES[p] << "=" << h.percentile(PERCENTILES[p]);
+            std::cout << " max=" << h.max() << " samples=" << h.count() << "\n";
+        }
+        if (ContentionStats::enabled) {
+            std::cout << "  contention:";
+            for (int c = 0; c < ContentionStats::COUNTERS; ++c) {
+                std::cout << " " << ContentionStats::NAMES[c] << "=" << result.contention.values[c];
+            }
+            std::cout << "\n";
+        }
     }
-    return ops_per_sec;
+    return result;
+}
+
+struct BenchOutput {
+    std::ofstream csv;
+    std::map<std::string, double> baseline;   // 1-thread ops/sec per implementation
+    std::map<std::string, double> unscanned;  // ops/sec without scanners, per implementation and threads
+};
+
+template <typename ListType, typename... Args>
+void bench_impl(const BenchConfig& cfg, const std::string& label, BenchOutput& out, Args... args) {
+    if (cfg.batch > 1 && !has_batch<ListType>::value) return;
+    if (cfg.scanners > 0 && !has_range<ListType>::value) return;
+
+    double avg = 0;
+    double allocs = 0;
+    double find_rate = 0;
+    double update_rate = 0;
+    double scan_rate = 0;
+    double scanned_keys = 0;
+    double contention[ContentionStats::COUNTERS] = {};
+    double total_ops = 0;
+    double cache_misses = 0;   // stays -1 if any repeat could not count them
+    double load_factor = 0;    // -1 for structures without one, like cache_misses
+    double resizes = 0;
+    size_t live = 0;
+    size_t peak = 0;
+    // latency over all repeats
+    LatencyHistogram latency[OP_TYPES];
+    for (int r = 0; r < cfg.repeats; ++r) {
+        RunResult result = run_once<ListType>(cfg, label, args...);
+        for (int op = 0; op < OP_TYPES; ++op) latency[op].merge(result.latency[op]);
+        avg += result.ops_per_sec;
+        allocs += result.allocs_per_sec;
+        find_rate += result.find_ops_per_sec;
+        update_rate += result.update_ops_per_sec;
+        scan_rate += result.scans_per_sec;
+        scanned_keys += result.scanned_keys_per_sec;
+        for (int c = 0; c < ContentionStats::COUNTERS; ++c) contention[c] += double(result.contention.values[c]);
+        total_ops += result.operations;
+        cache_misses = cache_misses < 0 || result.cache_misses < 0 ? -1 : cache_misses + double(result.cache_misses);
+        load_factor = load_factor < 0 || result.load_factor < 0 ? -1 : load_factor + result.load_factor;
+        resizes = resizes < 0 || result.resizes < 0 ? -1 : resizes + result.resizes;
+        if (!result.timeline.empty()) {
+            std::ofstream timeline(cfg.timeline_file, std::ios::app);
+            for (size_t sec = 0; sec < result.timeline.size(); ++sec) {
+                timeline << label << "," << cfg.threads << "," << r << "," << (sec + 1) << ","
+                         << result.timeline[sec] << "\n";
+            }
+        }
+        live = result.live_bytes;
+        peak = std::max(peak, result.peak_bytes);
+        if (cfg.verbose) {
+            std::cout << "  " << label << " run " << (r + 1) << "/" << cfg.repeats
+                      << ": " << result.ops_per_sec << " ops/s\n";
+        }
+    }
+    avg /= cfg.repeats;
+    allocs /= cfg.repeats;
+    find_rate /= cfg.repeats;
+    update_rate /= cfg.repeats;
+    scan_rate /= cfg.repeats;
+    scanned_keys /= cfg.repeats;
+    for (double& c : contention) c /= cfg.repeats;
+    total_ops /= cfg.repeats;
+    if (cache_misses > 0) cache_misses /= cfg.repeats;
+    if (load_factor > 0) load_factor /= cfg.repeats;
+    if (resizes > 0) resizes /= cfg.repeats;
+    double misses_per_op = cache_misses < 0 ? -1 : total_ops > 0 ? cache_misses / total_ops : 0;
+
+    if (cfg.verbose) {
+        std::cout << "  " << label << " average: " << avg << " ops/s\n";
+    }
+
+    std::string key = label + "/" + std::to_string(cfg.batch) + "/" + std::to_string(cfg.scanners);
+    if (cfg.threads == 1) out.baseline[key] = avg;
+    // throughput ratios are the speedup in both modes: under weak scaling p threads do p times
+    // the work, so p * T1 / Tp reduces to the same ratio
+    double speedup = out.baseline.count(key) ? avg / out.baseline[key] : 0;
+    double efficiency = speedup / cfg.threads;
+    if (cfg.verbose) {
+        std::cout << "  " << label << " speedup: " << speedup << " efficiency: " << efficiency << "\n";
+    }
+
+    // how much the scanners slow the workers down against the same run without them
+    std::string workers_key = label + "/" + std::to_string(cfg.batch) + "/" + std::to_string(cfg.threads);
+    if (cfg.scanners == 0) out.unscanned[workers_key] = avg;
+    double slowdown = out.unscanned.count(workers_key) ? out.unscanned[workers_key] / avg : 0;
+
+    std::ofstream& csv = out.csv;
+    csv << label << "," << cfg.threads << "," << cfg.batch << "," << avg << ","
+        << avg / cfg.threads << "," << speedup << "," << efficiency << ","
+        << cfg.p_insert << "," << cfg.p_remove << ","
+        << scaling_name(cfg.scaling) << "," << cfg.operations << "," << thread_ops(cfg, 0) << ","
+        << cfg.key_range << "," << key_type_name(cfg.key_type) << ","
+        << (cfg.pool ? "pool" : "system") << "," << allocs << "," << live << "," << peak << ","
+        << cfg.workload.describe() << "," << cfg.prefill << "," << cfg.duration << "," << cfg.readers << ","
+        << find_rate << "," << update_rate << ","
+        << cfg.scanners << "," << cfg.scan_width << "," << scan_rate << "," << scanned_keys << "," << slowdown << ","
+        << misses_per_op << "," << load_factor << "," << resizes;
+    if (ContentionStats::enabled) {
+        // per-run averages; nodes_per_op divides traversal by the operations of the workers
+        for (double c : contention) csv << "," << c;
+        csv << "," << (total_ops > 0 ? contention[ContentionStats::NODES_TRAVERSED] / total_ops : 0);
+    }
+    for (int op = 0; op < OP_TYPES; ++op) {
+        for (double p : PERCENTILES) csv << "," << latency[op].percentile(p);
+        csv << "," << latency[op].max();
+    }
+    csv << "\n";
+}
+
+// the lists templated on their key; everything else takes int keys only
+template <typename Key, typename Value>
+void bench_keyed(const BenchConfig& cfg, BenchOutput& out) {
+    using Coarse = BasicCoarseList<Key, Value>;
+    using Fine = BasicFineList<Key, Value>;
+    bench_impl<Coarse>(cfg, "coarse", out);
+    bench_impl<Fine>(cfg, "fine", out);
+    bench_impl<Fine>(cfg, "fine-leak", out, Fine::Reclamation::Leak);
 }
 
 int main(int argc, char** argv) {
@@ -181,6 +747,20 @@ int main(int argc, char** argv) {
         return "1,2,4,8";
     }());
 
+    // speedup and efficiency are relative to one thread, so that run always comes first
+    std::sort(thread_counts.begin(), thread_counts.end());
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+    if (thread_counts.empty() || thread_counts.front() != 1) {
+        thread_counts.insert(thread_counts.begin(), 1);
+    }
+    // writer_slowdown is relative to the same run without scanners, so that run comes first too
+    std::vector<int>& scanner_counts = config.scanner_counts;
+    std::sort(scanner_counts.begin(), scanner_counts.end());
+    scanner_counts.erase(std::unique(scanner_counts.begin(), scanner_counts.end()), scanner_counts.end());
+    if (scanner_counts.empty() || scanner_counts.front() != 0) {
+        scanner_counts.insert(scanner_counts.begin(), 0);
+    }
+
     if (config.verbose) {
         std::cout << "Benchmark Configuration:\n"
                   << "  Thread counts: ";
@@ -189,66 +769,91 @@ int main(int argc, char** argv) {
             if (i < thread_counts.size() - 1) std::cout << ", ";
         }
         std::cout << "\n"
-                  << "  Operations per thread: " << config.ops_per_thread << "\n"
+                  << "  Scaling: " << scaling_name(config.scaling) << "\n"
+                  << "  Operations: " << config.operations
+                  << (config.scaling == Scaling::Strong ? " per run\n" : " per thread\n")
                   << "  Insert ratio: " << config.p_insert << "\n"
                   << "  Remove ratio: " << config.p_remove << "\n"
                   << "  Find ratio: " << (1.0 - config.p_insert - config.p_remove) << "\n"
                   << "  Key range: " << config.key_range << "\n"
+                  << "  Key type: " << key_type_name(config.key_type) << "\n"
                   << "  Repeats: " << config.repeats << "\n"
-                  << "  Output file: " << config.output_file << "\n";
+                  << "  Output file: " << config.output_file << "\n"
+                  << "  Allocator: " << (config.pool ? "pool" : "system") << "\n"
+                  << "  Latency sampling: every " << config.sample_every << " ops\n"
+                  << "  Key distribution: " << config.workload.describe() << "\n"
+                  << "  Prefill: " << config.prefill << " keys\n"
+                  << "  Duration: " << (config.duration > 0 ? std::to_string(config.duration) + "s" : "fixed operations") << "\n"
+                  << "  Roles: " << (config.readers >= 0 ? std::to_string(config.readers) + " readers, rest writers" : "mixed") << "\n"
+                  << "  Scan width: " << config.scan_width << " keys\n";
+    }
+
+    NodePool::set_enabled(config.pool);
+
+    BenchOutput out;
+    out.csv.open(config.output_file);
+    std::ofstream& csv = out.csv;
+    csv << "impl,threads,batch,ops_per_sec,per_thread_ops_per_sec,speedup,efficiency,"
+        << "p_insert,p_remove,scaling,operations,ops_per_thread,key_range,key_type,"
+        << "allocator,allocs_per_sec,live_bytes,peak_bytes,"
+        << "distribution,prefill,duration,readers,find_ops_per_sec,update_ops_per_sec,"
+        << "scanners,scan_width,scans_per_sec,scanned_keys_per_sec,writer_slowdown,"
+        << "cache_misses_per_op,load_factor,resizes";
+    if (ContentionStats::enabled) {
+        for (const char* name : ContentionStats::NAMES) csv << "," << name;
+        csv << ",nodes_per_op";
     }
+    for (const char* op : OP_NAMES) {
+        for (const char* p : PERCENTILE_NAMES) csv << "," << op << "_" << p << "_ns";
+        csv << "," << op << "_max_ns";
+    }
+    csv << "\n";
 
-    std::ofstream csv(config.output_file);
-    csv << "impl,threads,ops_per_sec,p_insert,p_remove,ops_per_thread,key_range\n";
+    if (config.duration > 0) {
+        std::ofstream timeline(config.timeline_file);
+        timeline << "impl,threads,repeat,second,ops_per_sec\n";
+    }
 
     for (int t : thread_counts) {
-        BenchConfig run_config = config;
-        run_config.threads = t;
+        for (int b : config.batch_sizes) {
+            for (int sc : config.scanner_counts) {
+                BenchConfig run_config = config;
+                run_config.threads = t;
+                run_config.batch = b;
+                run_config.scanners = sc;
 
-        if (config.verbose) {
-            std::cout << "\nRunning with " << t << " threads...\n";
-        }
+                if (config.verbose) {
+                    std::cout << "\nRunning with " << t << " threads, batch " << b << ", " << sc << " scanners...\n";
+                }
 
-        double avg_coarse = 0;
-        for (int r = 0; r < config.repeats; ++r) {
-            double result = run_once<CoarseList>(run_config, "coarse");
-            avg_coarse += result;
-            if (config.verbose) {
-                std::cout << "  Coarse run " << (r + 1) << "/" << config.repeats 
-                          << ": " << result << " ops/s\n";
-            }
-        }
-        avg_coarse /= config.repeats;
-        
-        if (config.verbose) {
-            std::cout << "  Coarse average: " << avg_coarse << " ops/s\n";
-        }
-        
-        csv << "coarse," << t << "," << avg_coarse << "," 
-            << config.p_insert << "," << config.p_remove << "," 
-            << config.ops_per_thread << "," << config.key_range << "\n";
-
-        double avg_fine = 0;
-        for (int r = 0; r < config.repeats; ++r) {
-            double result = run_once<FineList>(run_config, "fine");
-            avg_fine += result;
-            if (config.verbose) {
-                std::cout << "  Fine run " << (r + 1) << "/" << config.repeats 
-                          << ": " << result << " ops/s\n";
+                if (config.key_type == KeyType::Int64) {
+                    bench_keyed<int64_t, void>(run_config, out);
+                    continue;
+                }
+                if (config.key_type == KeyType::String) {
+                    bench_keyed<std::string, uint64_t>(run_config, out);
+                    continue;
+                }
+
+                bench_impl<CoarseList>(run_config, "coarse", out);
+                bench_impl<RWCoarseList>(run_config, "coarse-rw", out);
+                bench_impl<SeqlockCoarseList>(run_config, "coarse-seqlock", out);
+                bench_impl<FlatCombiningList>(run_config, "flatcombine", out);
+                bench_impl<FineList>(run_config, "fine", out);
+                bench_impl<FineList>(run_config, "fine-leak", out, FineList::Reclamation::Leak);
+                bench_impl<UnrolledList>(run_config, "unrolled", out);
+                bench_impl<LockFreeList>(run_config, "lockfree", out);
+                bench_impl<SkipList>(run_config, "skiplist", out);
+                bench_impl<SnapshotList>(run_config, "snapshot", out);
+                bench_impl<SplitOrderedSet>(run_config, "splitorder", out);
             }
         }
-        avg_fine /= config.repeats;
-        
-        if (config.verbose) {
-            std::cout << "  Fine average: " << avg_fine << " ops/s\n";
-        }
-        
-        csv << "fine," << t << "," << avg_fine << "," 
-            << config.p_insert << "," << config.p_remove << "," 
-            << config.ops_per_thread << "," << config.key_range << "\n";
     }
 
-    csv.close();
+    out.csv.close();
     std::cout << "Results written to " << config.output_file << "\n";
+    if (config.duration > 0) {
+        std::cout << "Timeline written to " << config.timeline_file << "\n";
+    }
     return 0;
 }
@@ -18,6 +18,10 @@ def plot_results(csv_file):
     
     plt.figure(figsize=(10, 6))
     
+    if 'batch' in df.columns:
+        df['impl'] = df['impl'] + df['batch'].map(lambda b: '' if b == 1 else f' (batch {b})')
+    if 'scanners' in df.columns:
+        df['impl'] = df['impl'] + df['scanners'].map(lambda s: '' if s == 0 else f' ({s} scanners)')
     pivot = df.pivot(index='threads', columns='impl', values='ops_per_sec')
     pivot.plot(marker='o', linewidth=2, markersize=8)
     
@@ -13,11 +13,39 @@ echo -e "\n=== High Read Workload (90% find) ==="
 echo -e "\n=== High Write Workload (50% updates) ==="
 ./bin/list_bench -t 1,2,4,8 -i 0.25 -r 0.25 -f 0.5 -O results_high_write.csv
 
+echo -e "\n=== High Write Workload, system allocator ==="
+./bin/list_bench -t 1,2,4,8 -i 0.25 -r 0.25 -f 0.5 -a system -O results_high_write_system.csv
+
 echo -e "\n=== Mixed Workload ==="
 ./bin/list_bench -t 1,4,16 -i 0.1 -r 0.2 -f 0.7 -o 50000 -O results_mixed.csv
 
+echo -e "\n=== High Contention (write-heavy, 16-64 threads) ==="
+./bin/list_bench -t 16,32,64 -i 0.4 -r 0.4 -f 0.2 -k 2000 -p 1000 -o 200000 -O results_contention.csv
+
+echo -e "\n=== Weak Scaling (20000 operations per thread) ==="
+./bin/list_bench -t 1,2,4,8 -S weak -o 20000 -O results_weak.csv
+
+echo -e "\n=== Key Types (64-bit IDs, 12-character strings with payloads) ==="
+./bin/list_bench -t 1,2,4 -k 20000 -p 10000 -K int64 -O results_keys_int64.csv
+./bin/list_bench -t 1,2,4 -k 20000 -p 10000 -K string -O results_keys_string.csv
+
+echo -e "\n=== Key Ranges (unrolled nodes against one key per node; cache_misses_per_op needs perf access) ==="
+for k in 1000 10000 100000; do
+    ./bin/list_bench -t 1,4 -k $k -p $((k / 2)) -O results_range_$k.csv
+done
+
+echo -e "\n=== Batch Sizes (batched lists against single-key calls) ==="
+./bin/list_bench -t 1,4 -b 1,16,256,4096 -k 100000 -p 20000 -O results_batch.csv
+
+echo -e "\n=== Range Queries (scanner threads against the update workload) ==="
+./bin/list_bench -t 1,2,4 -k 100000 -p 50000 -i 0.25 -r 0.25 -f 0.5 -c 0,1,2 -w 1000 -O results_scan.csv
+
+echo -e "\n=== Steady State (prefilled, Zipfian keys, 5 s per run, reader/writer roles) ==="
+./bin/list_bench -t 2,4 -k 40000 -p 20000 -d zipf:0.99 -D 5 -R 1 -n 1 \
+    -O results_steady.csv -T timeline_steady.csv
+
 echo -e "\n=== Generating plots ==="
-for csv in results.csv results_high_read.csv results_high_write.csv results_mixed.csv; do
+for csv in results.csv results_high_read.csv results_high_write.csv results_high_write_system.csv results_mixed.csv results_contention.csv results_weak.csv results_keys_int64.csv results_keys_string.csv results_range_1000.csv results_range_10000.csv results_range_100000.csv results_batch.csv results_scan.csv results_steady.csv; do
     if [ -f "$csv" ]; then
         python3 plot_results.py "$csv"
     fi
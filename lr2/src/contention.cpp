@@ -0,0 +1,37 @@
+#include "contention.h"
+
+const char* const ContentionStats::NAMES[COUNTERS] = {
+    "list_lock_acquires", "list_lock_contended", "list_lock_wait_ns",
+    "node_lock_acquires", "node_lock_contended", "node_lock_wait_ns",
+    "validate_retries", "nodes_traversed", "cas_failures"
+};
+
+static std::mutex exited_mtx;
+static ContentionStats::Totals exited;
+
+struct ContentionHolder {
+    ContentionStats::Totals counts;
+    ~ContentionHolder() {
+        std::lock_guard<std::mutex> lg(exited_mtx);
+        for (int c = 0; c < ContentionStats::COUNTERS; ++c) exited.values[c] += counts.values[c];
+    }
+};
+
+static thread_local ContentionHolder holder;
+
+ContentionStats::Totals& ContentionStats::local() {
+    return holder.counts;
+}
+
+ContentionStats::Totals ContentionStats::total() {
+    std::lock_guard<std::mutex> lg(exited_mtx);
+    Totals sum = exited;
+    for (int c = 0; c < COUNTERS; ++c) sum.values[c] += holder.counts.values[c];
+    return sum;
+}
+
+void ContentionStats::reset() {
+    std::lock_guard<std::mutex> lg(exited_mtx);
+    exited = Totals();
+    holder.counts = Totals();
+}
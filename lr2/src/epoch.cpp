@@ -0,0 +1,125 @@
+#include "epoch.h"
+
+std::atomic<uint64_t> EpochReclaimer::global_epoch{2};
+std::atomic<EpochReclaimer::Record*> EpochReclaimer::records{nullptr};
+std::atomic<size_t> EpochReclaimer::freed_count{0};
+
+struct EpochRecordHolder {
+    EpochReclaimer::Record* rec = nullptr;
+    ~EpochRecordHolder() {
+        if (rec) EpochReclaimer::release(rec);
+    }
+};
+
+static thread_local EpochRecordHolder holder;
+
+EpochReclaimer::Record* EpochReclaimer::local() {
+    if (!holder.rec) holder.rec = acquire();
+    return holder.rec;
+}
+
+EpochReclaimer::Record* EpochReclaimer::acquire() {
+    for (Record* rec = records.load(); rec; rec = rec->next) {
+        bool expected = false;
+        if (!rec->in_use.load() && rec->in_use.compare_exchange_strong(expected, true)) {
+            return rec;
+        }
+    }
+
+    Record* rec = new Record();
+    rec->state.store(0);
+    rec->in_use.store(true);
+    Record* head = records.load();
+    do {
+        rec->next = head;
+    } while (!records.compare_exchange_weak(head, rec));
+    return rec;
+}
+
+void EpochReclaimer::release(Record* rec) {
+    try_advance();
+    free_expired(rec, global_epoch.load());
+    // whatever is still too young stays in the record for its next owner
+    rec->in_use.store(false);
+}
+
+void EpochReclaimer::pin() {
+    Record* rec = local();
+    if (rec->nesting++ > 0) return;
+
+    uint64_t e = global_epoch.load();
+    rec->state.store((e << 1) | 1);
+    if (rec->since_collect >= BATCH_SIZE) {
+        free_expired(rec, e);
+    }
+}
+
+void EpochReclaimer::unpin() {
+    Record* rec = local();
+    if (--rec->nesting > 0) return;
+    rec->state.store(rec->state.load(std::memory_order_relaxed) & ~uint64_t(1), std::memory_order_release);
+}
+
+bool EpochReclaimer::try_advance() {
+    uint64_t e = global_epoch.load();
+    for (Record* rec = records.load(); rec; rec = rec->next) {
+        uint64_t s = rec->state.load();
+        if ((s & 1) && (s >> 1) != e) return false;
+    }
+    return global_epoch.compare_exchange_strong(e, e + 1);
+}
+
+size_t EpochReclaimer::free_expired(Record* rec, uint64_t epoch) {
+    size_t count = 0;
+    for (int b = 0; b < 3; ++b) {
+        if (rec->limbo[b].empty() || rec->limbo_epoch[b] + 2 > epoch) continue;
+        for (const Retired& r : rec->limbo[b]) {
+            r.deleter(r.ptr);
+        }
+        count += rec->limbo[b].size();
+        rec->limbo[b].clear();
+    }
+    rec->since_collect = 0;
+    freed_count.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+void EpochReclaimer::retire_raw(void* p, void (*deleter)(void*)) {
+    Record* rec = local();
+    uint64_t e = global_epoch.load();
+    int b = e % 3;
+
+    // a bucket last filled three or more epochs ago is already safe to free
+    if (rec->limbo_epoch[b] != e) {
+        if (!rec->limbo[b].empty()) {
+            for (const Retired& r : rec->limbo[b]) r.deleter(r.ptr);
+            freed_count.fetch_add(rec->limbo[b].size(), std::memory_order_relaxed);
+            rec->limbo[b].clear();
+        }
+        rec->limbo_epoch[b] = e;
+    }
+    rec->limbo[b].push_back({p, deleter});
+
+    if (++rec->since_collect >= BATCH_SIZE) {
+        try_advance();
+        if (rec->nesting == 0) free_expired(rec, global_epoch.load());
+    }
+}
+
+size_t EpochReclaimer::collect() {
+    try_advance();
+    return free_expired(local(), global_epoch.load());
+}
+
+uint64_t EpochReclaimer::epoch() {
+    return global_epoch.load();
+}
+
+size_t EpochReclaimer::pending() {
+    Record* rec = local();
+    return rec->limbo[0].size() + rec->limbo[1].size() + rec->limbo[2].size();
+}
+
+size_t EpochReclaimer::freed() {
+    return freed_count.load();
+}
@@ -0,0 +1,200 @@
+#include "hash_set.h"
+#include "contention.h"
+#include "epoch.h"
+
+static const uintptr_t MARK = 1;
+
+static inline bool is_marked(uintptr_t word) { return word & MARK; }
+
+template <typename Node>
+static inline Node* pointer(uintptr_t word) { return reinterpret_cast<Node*>(word & ~MARK); }
+
+static inline uint64_t reverse_bits(uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return __builtin_bswap64(x);
+}
+
+SplitOrderedSet::SplitOrderedSet() : buckets(2), count(0), resizes(0) {
+    for (auto& s : segments) s.store(nullptr, std::memory_order_relaxed);
+    slot(0).store(new Node(dummy_key(0), 0));
+}
+
+SplitOrderedSet::~SplitOrderedSet() {
+    Node* cur = slot(0).load();
+    while (cur) {
+        Node* tmp = pointer<Node>(cur->next.load());
+        delete cur;
+        cur = tmp;
+    }
+    for (auto& s : segments) delete[] s.load();
+}
+
+// murmur3 finalizer: a bijection on 32 bits, so distinct values never share a split-order key
+uint32_t SplitOrderedSet::hash(int value) {
+    uint32_t h = static_cast<uint32_t>(value);
+    h ^= h >> 16;
+    h *= 0x85EBCA6BU;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35U;
+    h ^= h >> 16;
+    return h;
+}
+
+uint64_t SplitOrderedSet::regular_key(uint32_t h) {
+    return reverse_bits(uint64_t(h) | (uint64_t(1) << 63));
+}
+
+uint64_t SplitOrderedSet::dummy_key(size_t bucket) {
+    return reverse_bits(uint64_t(bucket));
+}
+
+std::atomic<SplitOrderedSet::Node*>& SplitOrderedSet::slot(size_t bucket) {
+    std::atomic<std::atomic<Node*>*>& seg = segments[bucket >> SEGMENT_BITS];
+    std::atomic<Node*>* table = seg.load(std::memory_order_acquire);
+    if (!table) {
+        std::atomic<Node*>* fresh = new std::atomic<Node*>[SEGMENT_SIZE];
+        for (size_t i = 0; i < SEGMENT_SIZE; ++i) fresh[i].store(nullptr, std::memory_order_relaxed);
+        if (seg.compare_exchange_strong(table, fresh)) {
+            table = fresh;
+        } else {
+            delete[] fresh;
+        }
+    }
+    return table[bucket & (SEGMENT_SIZE - 1)];
+}
+
+SplitOrderedSet::Node* SplitOrderedSet::bucket_head(size_t bucket) {
+    Node* head = slot(bucket).load(std::memory_order_acquire);
+    if (!head) {
+        initialize_bucket(bucket);
+        head = slot(bucket).load(std::memory_order_acquire);
+    }
+    return head;
+}
+
+// Splits bucket off its parent (the bucket index without its top set bit) by inserting a
+// dummy node; a concurrent initialiser may win, in which case its dummy is adopted.
+void SplitOrderedSet::initialize_bucket(size_t bucket) {
+    size_t parent = bucket;
+    for (size_t bit = 1; bit <= bucket; bit <<= 1) {
+        if (bucket & bit) parent = bucket & ~bit;
+    }
+    Node* start = bucket_head(parent);
+
+    Node* dummy = new Node(dummy_key(bucket), 0);
+    Position pos;
+    while (true) {
+        if (search(start, dummy->key, pos)) {
+            delete dummy;
+            dummy = pos.curr;
+            break;
+        }
+        uintptr_t expected = reinterpret_cast<uintptr_t>(pos.curr);
+        dummy->next.store(expected, std::memory_order_relaxed);
+        if (pos.prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(dummy))) break;
+        ContentionStats::add(ContentionStats::CAS_FAILURES);
+    }
+    slot(bucket).store(dummy, std::memory_order_release);
+}
+
+// Positions pos at the first node at or after start with key >= target, unlinking marked
+// nodes on the way. The caller must be pinned.
+bool SplitOrderedSet::search(Node* start, uint64_t key, Position& pos) {
+try_again:
+    std::atomic<uintptr_t>* prev = &start->next;
+    Node* curr = pointer<Node>(prev->load());
+
+    while (true) {
+        if (!curr) {
+            pos = {prev, nullptr};
+            return false;
+        }
+
+        uintptr_t next_word = curr->next.load();
+        Node* next = pointer<Node>(next_word);
+
+        if (is_marked(next_word)) {
+            uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+            if (!prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(next))) {
+                ContentionStats::add(ContentionStats::CAS_FAILURES);
+                goto try_again;
+            }
+            EpochReclaimer::retire(curr);
+            curr = next;
+            continue;
+        }
+
+        if (curr->key >= key) {
+            pos = {prev, curr};
+            return curr->key == key;
+        }
+
+        prev = &curr->next;
+        curr = next;
+    }
+}
+
+bool SplitOrderedSet::find(int value) {
+    EpochReclaimer::Guard guard;
+    uint32_t h = hash(value);
+    Position pos;
+    return search(bucket_head(h & (buckets.load() - 1)), regular_key(h), pos);
+}
+
+bool SplitOrderedSet::insert(int value) {
+    EpochReclaimer::Guard guard;
+    uint32_t h = hash(value);
+    size_t size = buckets.load();
+    Node* start = bucket_head(h & (size - 1));
+    Node* node = new Node(regular_key(h), value);
+    Position pos;
+
+    while (true) {
+        if (search(start, node->key, pos)) {
+            delete node;
+            return false;
+        }
+
+        uintptr_t expected = reinterpret_cast<uintptr_t>(pos.curr);
+        node->next.store(expected, std::memory_order_relaxed);
+        if (pos.prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node))) break;
+        ContentionStats::add(ContentionStats::CAS_FAILURES);
+    }
+
+    // growing only publishes a larger bucket count; no key moves
+    if (count.fetch_add(1) + 1 > int64_t(MAX_LOAD * size) && size * 2 <= MAX_BUCKETS) {
+        if (buckets.compare_exchange_strong(size, size * 2)) resizes.fetch_add(1);
+    }
+    return true;
+}
+
+bool SplitOrderedSet::remove(int value) {
+    EpochReclaimer::Guard guard;
+    uint32_t h = hash(value);
+    Node* start = bucket_head(h & (buckets.load() - 1));
+    uint64_t key = regular_key(h);
+    Position pos;
+
+    while (true) {
+        if (!search(start, key, pos)) return false;
+
+        uintptr_t next_word = pos.curr->next.load();
+        if (is_marked(next_word)) continue;
+        if (!pos.curr->next.compare_exchange_strong(next_word, next_word | MARK)) {
+            ContentionStats::add(ContentionStats::CAS_FAILURES);
+            continue;
+        }
+
+        uintptr_t expected = reinterpret_cast<uintptr_t>(pos.curr);
+        if (pos.prev->compare_exchange_strong(expected, next_word)) {
+            EpochReclaimer::retire(pos.curr);
+        } else {
+            ContentionStats::add(ContentionStats::CAS_FAILURES);
+            search(start, key, pos);
+        }
+        count.fetch_sub(1);
+        return true;
+    }
+}
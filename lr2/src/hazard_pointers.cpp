@@ -0,0 +1,90 @@
+#include "hazard_pointers.h"
+#include <algorithm>
+
+std::atomic<HazardPointers::Record*> HazardPointers::records{nullptr};
+std::atomic<int> HazardPointers::record_count{0};
+
+struct HazardRecordHolder {
+    HazardPointers::Record* rec = nullptr;
+    ~HazardRecordHolder() {
+        if (rec) HazardPointers::release(rec);
+    }
+};
+
+static thread_local HazardRecordHolder holder;
+
+HazardPointers::Record* HazardPointers::local() {
+    if (!holder.rec) holder.rec = acquire();
+    return holder.rec;
+}
+
+HazardPointers::Record* HazardPointers::acquire() {
+    for (Record* rec = records.load(); rec; rec = rec->next) {
+        bool expected = false;
+        if (!rec->active.load() && rec->active.compare_exchange_strong(expected, true)) {
+            return rec;
+        }
+    }
+
+    Record* rec = new Record();
+    for (auto& h : rec->hazards) h.store(nullptr);
+    rec->active.store(true);
+    Record* head = records.load();
+    do {
+        rec->next = head;
+    } while (!records.compare_exchange_weak(head, rec));
+    record_count.fetch_add(1);
+    return rec;
+}
+
+void HazardPointers::release(Record* rec) {
+    for (auto& h : rec->hazards) h.store(nullptr);
+    scan(rec);
+    // nodes still protected by other threads stay in the record for its next owner
+    rec->active.store(false);
+}
+
+std::atomic<void*>* HazardPointers::slots() {
+    return local()->hazards;
+}
+
+void HazardPointers::protect(int slot, void* p) {
+    local()->hazards[slot].store(p);
+}
+
+void HazardPointers::clear() {
+    Record* rec = local();
+    for (auto& h : rec->hazards) h.store(nullptr, std::memory_order_release);
+}
+
+void HazardPointers::retire_raw(void* p, void (*deleter)(void*)) {
+    Record* rec = local();
+    rec->retired.push_back({p, deleter});
+    size_t threshold = std::max<size_t>(64, 2 * SLOTS * record_count.load());
+    if (rec->retired.size() >= threshold) scan(rec);
+}
+
+void HazardPointers::scan(Record* rec) {
+    std::vector<void*> hazards;
+    for (Record* r = records.load(); r; r = r->next) {
+        for (auto& h : r->hazards) {
+            void* p = h.load();
+            if (p) hazards.push_back(p);
+        }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    std::vector<Retired> keep;
+    for (const Retired& r : rec->retired) {
+        if (std::binary_search(hazards.begin(), hazards.end(), r.ptr)) {
+            keep.push_back(r);
+        } else {
+            r.deleter(r.ptr);
+        }
+    }
+    rec->retired.swap(keep);
+}
+
+size_t HazardPointers::pending() {
+    return local()->retired.size();
+}
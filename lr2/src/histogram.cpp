@@ -0,0 +1,37 @@
+#include "histogram.h"
+#include <algorithm>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() : counts(bucket_count(), 0), total(0), max_value(0) {}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    max_value = std::max(max_value, other.max_value);
+}
+
+void LatencyHistogram::clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    max_value = 0;
+}
+
+uint64_t LatencyHistogram::highest_in(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    int shift = int(index / SUB_BUCKETS) - 1;
+    uint64_t top = SUB_BUCKETS + index % SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (total == 0) return 0;
+    uint64_t rank = std::max<uint64_t>(1, uint64_t(std::ceil(p / 100.0 * double(total))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(highest_in(i), max_value);
+    }
+    return max_value;
+}
@@ -1,9 +1,23 @@
 #include "list_coarse.h"
+#include "contention.h"
+#include "utils.h"
 #include <cstdlib>
 
-CoarseList::CoarseList(): head(nullptr) {}
+template <typename Key, typename Value, typename Compare>
+BasicCoarseList<Key, Value, Compare>::BasicCoarseList(): head(nullptr) {}
 
-CoarseList::~CoarseList() {
+template <typename Key, typename Value, typename Compare>
+BasicCoarseList<Key, Value, Compare>::BasicCoarseList(const std::vector<Key>& sorted_keys): head(nullptr) {
+    Node** tailp = &head;
+    for (size_t i = 0; i < sorted_keys.size(); ++i) {
+        if (i > 0 && !cmp(sorted_keys[i - 1], sorted_keys[i])) continue;
+        *tailp = new Node(sorted_keys[i], value_arg());
+        tailp = &((*tailp)->next);
+    }
+}
+
+template <typename Key, typename Value, typename Compare>
+BasicCoarseList<Key, Value, Compare>::~BasicCoarseList() {
     std::lock_guard<std::mutex> lg(mtx);
     Node* cur = head;
     while (cur) {
@@ -13,39 +27,125 @@ CoarseList::~CoarseList() {
     }
 }
 
-bool CoarseList::insert(int value) {
-    std::lock_guard<std::mutex> lg(mtx);
-    Node** curp = &head;
-    while (*curp) {
-        if ((*curp)->value == value) return false;
+// Advances from *from to the link of the first node not ordered before probe.
+template <typename Key, typename Value, typename Compare>
+typename BasicCoarseList<Key, Value, Compare>::Node**
+BasicCoarseList<Key, Value, Compare>::locate(const typename Ops::Probe& probe, Node** from, uint64_t& steps) {
+    Node** curp = from;
+    while (*curp && Ops::less((*curp)->key, probe, cmp)) {
         curp = &((*curp)->next);
+        ++steps;
     }
-    Node* node = new Node(value);
+    return curp;
+}
+
+template <typename Key, typename Value, typename Compare>
+bool BasicCoarseList<Key, Value, Compare>::insert(const Key& key, const value_arg& value) {
+    typename Ops::Probe probe(key);
+    uint64_t steps = 0;
+    auto lg = ContentionStats::acquire(mtx, ContentionStats::LOCK_LIST);
+    Node** curp = locate(probe, &head, steps);
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    if (*curp && !Ops::greater((*curp)->key, probe, cmp)) return false;
+    Node* node = new Node(key, value);
+    node->next = *curp;
     *curp = node;
     return true;
 }
 
-bool CoarseList::remove(int value) {
-    std::lock_guard<std::mutex> lg(mtx);
+template <typename Key, typename Value, typename Compare>
+bool BasicCoarseList<Key, Value, Compare>::remove(const Key& key) {
+    typename Ops::Probe probe(key);
+    uint64_t steps = 0;
+    auto lg = ContentionStats::acquire(mtx, ContentionStats::LOCK_LIST);
+    Node** curp = locate(probe, &head, steps);
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    if (!*curp || Ops::greater((*curp)->key, probe, cmp)) return false;
+    Node* to_del = *curp;
+    *curp = to_del->next;
+    delete to_del;
+    return true;
+}
+
+template <typename Key, typename Value, typename Compare>
+bool BasicCoarseList<Key, Value, Compare>::find(const Key& key) {
+    typename Ops::Probe probe(key);
+    uint64_t steps = 0;
+    auto lg = ContentionStats::acquire(mtx, ContentionStats::LOCK_LIST);
+    Node** curp = locate(probe, &head, steps);
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return *curp && !Ops::greater((*curp)->key, probe, cmp);
+}
+
+template <typename Key, typename Value, typename Compare>
+bool BasicCoarseList<Key, Value, Compare>::get(const Key& key, value_arg& out) {
+    typename Ops::Probe probe(key);
+    uint64_t steps = 0;
+    auto lg = ContentionStats::acquire(mtx, ContentionStats::LOCK_LIST);
+    Node** curp = locate(probe, &head, steps);
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    if (!*curp || Ops::greater((*curp)->key, probe, cmp)) return false;
+    out = (*curp)->payload();
+    return true;
+}
+
+template <typename Key, typename Value, typename Compare>
+size_t BasicCoarseList<Key, Value, Compare>::insert_batch(const std::vector<Key>& keys) {
+    std::vector<Key> sorted = sorted_keys(keys, cmp);
+    size_t inserted = 0;
+    uint64_t steps = 0;
+    auto lg = ContentionStats::acquire(mtx, ContentionStats::LOCK_LIST);
     Node** curp = &head;
-    while (*curp) {
-        if ((*curp)->value == value) {
-            Node* to_del = *curp;
-            *curp = to_del->next;
-            delete to_del;
-            return true;
-        }
-        curp = &((*curp)->next);
+    for (const Key& key : sorted) {
+        typename Ops::Probe probe(key);
+        curp = locate(probe, curp, steps);
+        if (*curp && !Ops::greater((*curp)->key, probe, cmp)) continue;
+        Node* node = new Node(key, value_arg());
+        node->next = *curp;
+        *curp = node;
+        curp = &node->next;
+        ++inserted;
     }
-    return false;
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return inserted;
 }
 
-bool CoarseList::find(int value) {
-    std::lock_guard<std::mutex> lg(mtx);
-    Node* cur = head;
-    while (cur) {
-        if (cur->value == value) return true;
-        cur = cur->next;
+template <typename Key, typename Value, typename Compare>
+size_t BasicCoarseList<Key, Value, Compare>::remove_batch(const std::vector<Key>& keys) {
+    std::vector<Key> sorted = sorted_keys(keys, cmp);
+    size_t removed = 0;
+    uint64_t steps = 0;
+    auto lg = ContentionStats::acquire(mtx, ContentionStats::LOCK_LIST);
+    Node** curp = &head;
+    for (const Key& key : sorted) {
+        typename Ops::Probe probe(key);
+        curp = locate(probe, curp, steps);
+        if (!*curp || Ops::greater((*curp)->key, probe, cmp)) continue;
+        Node* to_del = *curp;
+        *curp = to_del->next;
+        delete to_del;
+        ++removed;
+    }
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return removed;
+}
+
+template <typename Key, typename Value, typename Compare>
+std::vector<bool> BasicCoarseList<Key, Value, Compare>::find_batch(const std::vector<Key>& keys) {
+    std::vector<size_t> order = sorted_order(keys, cmp);
+    std::vector<bool> found(keys.size(), false);
+    uint64_t steps = 0;
+    auto lg = ContentionStats::acquire(mtx, ContentionStats::LOCK_LIST);
+    Node** curp = &head;
+    for (size_t idx : order) {
+        typename Ops::Probe probe(keys[idx]);
+        curp = locate(probe, curp, steps);
+        found[idx] = *curp && !Ops::greater((*curp)->key, probe, cmp);
     }
-    return false;
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return found;
 }
+
+template class BasicCoarseList<int>;
+template class BasicCoarseList<int64_t>;
+template class BasicCoarseList<std::string, uint64_t>;
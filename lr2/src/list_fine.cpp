@@ -1,90 +1,255 @@
 #include "list_fine.h"
-#include <limits>
+#include "contention.h"
+#include "epoch.h"
+#include "utils.h"
 
-FineList::FineList() {
-    head = new Node(0);
-    tail = new Node(0);
-    head->next = tail;
+// head and tail hold default keys and are never compared: traversals start after head and
+// stop at tail by identity, so every Key value stays usable
+template <typename Key, typename Value, typename Compare>
+BasicFineList<Key, Value, Compare>::BasicFineList(Reclamation reclamation)
+    : reclamation(reclamation), leaked(nullptr) {
+    head = new Node(Key(), value_arg());
+    tail = new Node(Key(), value_arg());
+    head->next.store(tail);
 }
 
-FineList::~FineList() {
+template <typename Key, typename Value, typename Compare>
+BasicFineList<Key, Value, Compare>::BasicFineList(const std::vector<Key>& sorted_keys, Reclamation reclamation)
+    : BasicFineList(reclamation) {
+    Node* last = head;
+    for (size_t i = 0; i < sorted_keys.size(); ++i) {
+        if (i > 0 && !cmp(sorted_keys[i - 1], sorted_keys[i])) continue;
+        Node* node = new Node(sorted_keys[i], value_arg());
+        last->next.store(node, std::memory_order_relaxed);
+        last = node;
+    }
+    last->next.store(tail, std::memory_order_release);
+}
+
+template <typename Key, typename Value, typename Compare>
+BasicFineList<Key, Value, Compare>::~BasicFineList() {
     Node* cur = head;
     while (cur) {
-        Node* tmp = cur->next;
+        Node* tmp = cur->next.load();
         delete cur;
         cur = tmp;
     }
+    Node* node = leaked.load();
+    while (node) {
+        Node* tmp = node->leaked_next;
+        delete node;
+        node = tmp;
+    }
+}
+
+template <typename Key, typename Value, typename Compare>
+void BasicFineList<Key, Value, Compare>::retire(Node* node) {
+    if (reclamation == Reclamation::Epoch) {
+        EpochReclaimer::retire(node);
+        return;
+    }
+    node->leaked_next = leaked.load();
+    while (!leaked.compare_exchange_weak(node->leaked_next, node)) {}
+}
+
+// Sets curr to the first node not ordered before probe (or tail) and pred to the node before it.
+template <typename Key, typename Value, typename Compare>
+void BasicFineList<Key, Value, Compare>::locate(const Probe& probe, Node*& pred, Node*& curr) const {
+    pred = head;
+    curr = head->next.load(std::memory_order_acquire);
+    uint64_t steps = 0;
+    while (curr != tail && Ops::less(curr->key, probe, cmp)) {
+        pred = curr;
+        curr = curr->next.load(std::memory_order_acquire);
+        ++steps;
+    }
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+}
+
+// curr as returned by locate holds the probed key
+template <typename Key, typename Value, typename Compare>
+bool BasicFineList<Key, Value, Compare>::matches(Node* curr, const Probe& probe) const {
+    return curr != tail && !Ops::greater(curr->key, probe, cmp);
 }
 
-bool FineList::validate(Node* pred, Node* curr) const {
+template <typename Key, typename Value, typename Compare>
+bool BasicFineList<Key, Value, Compare>::validate(Node* pred, Node* curr) const {
     if (pred->marked.load(std::memory_order_acquire)) return false;
     if (curr->marked.load(std::memory_order_acquire)) return false;
-    return pred->next == curr;
+    return pred->next.load(std::memory_order_acquire) == curr;
 }
 
-bool FineList::find(int value) const {
-    Node* curr = head->next;
-    while (curr != tail) {
-        if (curr->value == value && !curr->marked.load(std::memory_order_acquire)) {
-            return true;
-        }
-        curr = curr->next;
-    }
-    return false;
+template <typename Key, typename Value, typename Compare>
+bool BasicFineList<Key, Value, Compare>::find(const Key& key) const {
+    EpochReclaimer::Guard guard;
+    Probe probe(key);
+    Node* pred;
+    Node* curr;
+    locate(probe, pred, curr);
+    return matches(curr, probe) && !curr->marked.load(std::memory_order_acquire);
+}
+
+// payloads never change after insertion, so reading one needs no lock
+template <typename Key, typename Value, typename Compare>
+bool BasicFineList<Key, Value, Compare>::get(const Key& key, value_arg& out) const {
+    EpochReclaimer::Guard guard;
+    Probe probe(key);
+    Node* pred;
+    Node* curr;
+    locate(probe, pred, curr);
+    if (!matches(curr, probe) || curr->marked.load(std::memory_order_acquire)) return false;
+    out = curr->payload();
+    return true;
 }
 
-bool FineList::insert(int value) {
+template <typename Key, typename Value, typename Compare>
+bool BasicFineList<Key, Value, Compare>::insert(const Key& key, const value_arg& value) {
+    EpochReclaimer::Guard guard;
+    Probe probe(key);
     while (true) {
-        Node* pred = head;
-        Node* curr = head->next;
-        
-        while (curr != tail) {
-            pred = curr;
-            curr = curr->next;
-        }
+        Node* pred;
+        Node* curr;
+        locate(probe, pred, curr);
 
-        std::unique_lock<std::mutex> lock_pred(pred->mtx);
-        std::unique_lock<std::mutex> lock_curr(curr->mtx);
+        auto lock_pred = ContentionStats::acquire(pred->mtx, ContentionStats::LOCK_NODE);
+        auto lock_curr = ContentionStats::acquire(curr->mtx, ContentionStats::LOCK_NODE);
 
         if (!validate(pred, curr)) {
+            ContentionStats::add(ContentionStats::VALIDATE_RETRIES);
             continue;
         }
 
-        Node* newNode = new Node(value);
-        newNode->next = tail;
-        pred->next = newNode;
+        if (matches(curr, probe)) {
+            return false;
+        }
+
+        Node* newNode = new Node(key, value);
+        newNode->next.store(curr, std::memory_order_relaxed);
+        pred->next.store(newNode, std::memory_order_release);
         return true;
     }
 }
 
-bool FineList::remove(int value) {
+template <typename Key, typename Value, typename Compare>
+bool BasicFineList<Key, Value, Compare>::remove(const Key& key) {
+    EpochReclaimer::Guard guard;
+    Probe probe(key);
     while (true) {
-        Node* pred = head;
-        Node* curr = head->next;
-
-        while (curr != tail && curr->value != value) {
-            pred = curr;
-            curr = curr->next;
-        }
+        Node* pred;
+        Node* curr;
+        locate(probe, pred, curr);
 
-        if (curr == tail) {
+        if (!matches(curr, probe)) {
             return false;
         }
 
-        std::unique_lock<std::mutex> lock_pred(pred->mtx);
-        std::unique_lock<std::mutex> lock_curr(curr->mtx);
+        auto lock_pred = ContentionStats::acquire(pred->mtx, ContentionStats::LOCK_NODE);
+        auto lock_curr = ContentionStats::acquire(curr->mtx, ContentionStats::LOCK_NODE);
 
         if (!validate(pred, curr)) {
+            ContentionStats::add(ContentionStats::VALIDATE_RETRIES);
             continue;
         }
 
-        if (curr->value != value) {
-            return false;
+        // logical deletion first, so wait-free finds never report a node being unlinked
+        curr->marked.store(true, std::memory_order_release);
+        pred->next.store(curr->next.load(std::memory_order_relaxed), std::memory_order_release);
+        lock_curr.unlock();
+        retire(curr);
+        return true;
+    }
+}
+
+// Holding pred's lock while locking its successor means every node reached is still linked
+// and unmarked: a remover needs the lock of the node before its victim, so no validation or
+// restart is needed during the pass.
+template <typename Key, typename Value, typename Compare>
+size_t BasicFineList<Key, Value, Compare>::insert_batch(const std::vector<Key>& keys) {
+    std::vector<Key> sorted = sorted_keys(keys, cmp);
+    size_t inserted = 0;
+    if (sorted.empty()) return 0;
+
+    EpochReclaimer::Guard guard;
+    Node* pred = head;
+    auto lock_pred = ContentionStats::acquire(pred->mtx, ContentionStats::LOCK_NODE);
+    uint64_t steps = 0;
+    for (const Key& key : sorted) {
+        Probe probe(key);
+        Node* curr = pred->next.load(std::memory_order_acquire);
+        while (curr != tail && Ops::less(curr->key, probe, cmp)) {
+            auto lock_curr = ContentionStats::acquire(curr->mtx, ContentionStats::LOCK_NODE);
+            lock_pred.swap(lock_curr);
+            pred = curr;
+            curr = pred->next.load(std::memory_order_acquire);
+            ++steps;
         }
+        if (matches(curr, probe)) continue;
+
+        Node* node = new Node(key, value_arg());
+        node->next.store(curr, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock_node(node->mtx);
+        pred->next.store(node, std::memory_order_release);
+        lock_pred.swap(lock_node);
+        pred = node;
+        ++inserted;
+    }
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return inserted;
+}
 
+template <typename Key, typename Value, typename Compare>
+size_t BasicFineList<Key, Value, Compare>::remove_batch(const std::vector<Key>& keys) {
+    std::vector<Key> sorted = sorted_keys(keys, cmp);
+    size_t removed = 0;
+    if (sorted.empty()) return 0;
+
+    EpochReclaimer::Guard guard;
+    Node* pred = head;
+    auto lock_pred = ContentionStats::acquire(pred->mtx, ContentionStats::LOCK_NODE);
+    uint64_t steps = 0;
+    for (const Key& key : sorted) {
+        Probe probe(key);
+        Node* curr = pred->next.load(std::memory_order_acquire);
+        while (curr != tail && Ops::less(curr->key, probe, cmp)) {
+            auto lock_curr = ContentionStats::acquire(curr->mtx, ContentionStats::LOCK_NODE);
+            lock_pred.swap(lock_curr);
+            pred = curr;
+            curr = pred->next.load(std::memory_order_acquire);
+            ++steps;
+        }
+        if (!matches(curr, probe)) continue;
+
+        auto lock_curr = ContentionStats::acquire(curr->mtx, ContentionStats::LOCK_NODE);
         curr->marked.store(true, std::memory_order_release);
-        pred->next = curr->next;
-        delete curr;
-        return true;
+        pred->next.store(curr->next.load(std::memory_order_relaxed), std::memory_order_release);
+        lock_curr.unlock();
+        retire(curr);
+        ++removed;
     }
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return removed;
 }
+
+template <typename Key, typename Value, typename Compare>
+std::vector<bool> BasicFineList<Key, Value, Compare>::find_batch(const std::vector<Key>& keys) const {
+    std::vector<size_t> order = sorted_order(keys, cmp);
+    std::vector<bool> found(keys.size(), false);
+
+    EpochReclaimer::Guard guard;
+    Node* curr = head->next.load(std::memory_order_acquire);
+    uint64_t steps = 0;
+    for (size_t idx : order) {
+        Probe probe(keys[idx]);
+        while (curr != tail && Ops::less(curr->key, probe, cmp)) {
+            curr = curr->next.load(std::memory_order_acquire);
+            ++steps;
+        }
+        found[idx] = matches(curr, probe) && !curr->marked.load(std::memory_order_acquire);
+    }
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return found;
+}
+
+template class BasicFineList<int>;
+template class BasicFineList<int64_t>;
+template class BasicFineList<std::string, uint64_t>;
@@ -0,0 +1,115 @@
+#include "list_flat.h"
+#include <algorithm>
+#include <thread>
+
+// spreads threads over the slots so each usually finds its own free
+static std::atomic<unsigned> next_hint{0};
+static thread_local unsigned slot_hint = next_hint.fetch_add(1);
+
+FlatCombiningList::FlatCombiningList(): head(nullptr), slot_limit(0) {
+    pending.reserve(MAX_SLOTS);
+}
+
+FlatCombiningList::~FlatCombiningList() {
+    std::lock_guard<std::mutex> lg(mtx);
+    Node* cur = head;
+    while (cur) {
+        Node* tmp = cur;
+        cur = cur->next;
+        delete tmp;
+    }
+}
+
+bool FlatCombiningList::insert(int value) {
+    return execute(OP_INSERT, value);
+}
+
+bool FlatCombiningList::remove(int value) {
+    return execute(OP_REMOVE, value);
+}
+
+bool FlatCombiningList::find(int value) {
+    return execute(OP_FIND, value);
+}
+
+int FlatCombiningList::claim() {
+    while (true) {
+        for (int i = 0; i < MAX_SLOTS; ++i) {
+            int idx = int((slot_hint + i) % MAX_SLOTS);
+            bool expected = false;
+            if (!slots[idx].claimed.load(std::memory_order_relaxed) &&
+                slots[idx].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                int limit = slot_limit.load();
+                while (limit <= idx && !slot_limit.compare_exchange_weak(limit, idx + 1)) {}
+                return idx;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+bool FlatCombiningList::execute(Op op, int value) {
+    int idx = claim();
+    Slot& slot = slots[idx];
+    slot.key = value;
+    slot.op.store(op, std::memory_order_release);
+
+    while (slot.op.load(std::memory_order_acquire) != OP_NONE) {
+        if (mtx.try_lock()) {
+            combine();
+            mtx.unlock();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    bool result = slot.result;
+    slot.claimed.store(false, std::memory_order_release);
+    return result;
+}
+
+// Applies every posted request in key order with one walk over the list. Requests on the same
+// key are applied in slot order, and each sees the effect of the ones before it.
+void FlatCombiningList::combine() {
+    pending.clear();
+    int limit = slot_limit.load();
+    for (int i = 0; i < limit; ++i) {
+        if (slots[i].op.load(std::memory_order_acquire) != OP_NONE) {
+            pending.push_back({slots[i].key, i});
+        }
+    }
+    std::sort(pending.begin(), pending.end(), [](const Request& a, const Request& b) {
+        return a.key < b.key || (a.key == b.key && a.slot < b.slot);
+    });
+
+    Node** curp = &head;
+    for (const Request& req : pending) {
+        Slot& slot = slots[req.slot];
+        while (*curp && (*curp)->value < req.key) {
+            curp = &((*curp)->next);
+        }
+        bool present = *curp && (*curp)->value == req.key;
+        switch (slot.op.load(std::memory_order_relaxed)) {
+            case OP_INSERT:
+                if (!present) {
+                    Node* node = new Node(req.key);
+                    node->next = *curp;
+                    *curp = node;
+                }
+                slot.result = !present;
+                break;
+            case OP_REMOVE:
+                if (present) {
+                    Node* to_del = *curp;
+                    *curp = to_del->next;
+                    delete to_del;
+                }
+                slot.result = present;
+                break;
+            default:
+                slot.result = present;
+                break;
+        }
+        slot.op.store(OP_NONE, std::memory_order_release);
+    }
+}
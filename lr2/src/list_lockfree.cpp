@@ -0,0 +1,129 @@
+#include "list_lockfree.h"
+#include "contention.h"
+#include "hazard_pointers.h"
+
+static const uintptr_t MARK = 1;
+
+static inline bool is_marked(uintptr_t word) { return word & MARK; }
+
+template <typename Node>
+static inline Node* pointer(uintptr_t word) { return reinterpret_cast<Node*>(word & ~MARK); }
+
+// hazard slots: 0 protects curr, 1 protects the node that owns prev
+static const int HP_CURR = 0;
+static const int HP_PREV = 1;
+
+LockFreeList::LockFreeList(): head(0) {}
+
+LockFreeList::~LockFreeList() {
+    Node* cur = pointer<Node>(head.load());
+    while (cur) {
+        Node* tmp = pointer<Node>(cur->next.load());
+        delete cur;
+        cur = tmp;
+    }
+}
+
+// Positions pos at the first node with value >= target, unlinking marked nodes on the way.
+// On return curr (if any) and the owner of prev are protected by hazard pointers.
+bool LockFreeList::search(int value, Position& pos) {
+    std::atomic<void*>* hazards = HazardPointers::slots();
+
+try_again:
+    std::atomic<uintptr_t>* prev = &head;
+    Node* curr = pointer<Node>(prev->load());
+
+    while (true) {
+        if (!curr) {
+            pos = {prev, nullptr};
+            return false;
+        }
+
+        hazards[HP_CURR].store(curr);
+        if (prev->load() != reinterpret_cast<uintptr_t>(curr)) goto try_again;
+
+        uintptr_t next_word = curr->next.load();
+        Node* next = pointer<Node>(next_word);
+
+        if (is_marked(next_word)) {
+            uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+            if (!prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(next))) {
+                ContentionStats::add(ContentionStats::CAS_FAILURES);
+                goto try_again;
+            }
+            HazardPointers::retire(curr);
+            curr = next;
+            continue;
+        }
+
+        int curr_value = curr->value;
+        if (prev->load() != reinterpret_cast<uintptr_t>(curr)) goto try_again;
+
+        if (curr_value >= value) {
+            pos = {prev, curr};
+            return curr_value == value;
+        }
+
+        hazards[HP_PREV].store(curr);
+        prev = &curr->next;
+        curr = next;
+        ContentionStats::add(ContentionStats::NODES_TRAVERSED);
+    }
+}
+
+bool LockFreeList::find(int value) {
+    Position pos;
+    bool found = search(value, pos);
+    HazardPointers::clear();
+    return found;
+}
+
+bool LockFreeList::insert(int value) {
+    Node* node = new Node(value);
+    Position pos;
+
+    while (true) {
+        if (search(value, pos)) {
+            HazardPointers::clear();
+            delete node;
+            return false;
+        }
+
+        uintptr_t expected = reinterpret_cast<uintptr_t>(pos.curr);
+        node->next.store(expected, std::memory_order_relaxed);
+        if (pos.prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node))) {
+            HazardPointers::clear();
+            return true;
+        }
+        ContentionStats::add(ContentionStats::CAS_FAILURES);
+    }
+}
+
+bool LockFreeList::remove(int value) {
+    Position pos;
+
+    while (true) {
+        if (!search(value, pos)) {
+            HazardPointers::clear();
+            return false;
+        }
+
+        uintptr_t next_word = pos.curr->next.load();
+        if (is_marked(next_word)) continue;
+        if (!pos.curr->next.compare_exchange_strong(next_word, next_word | MARK)) {
+            ContentionStats::add(ContentionStats::CAS_FAILURES);
+            continue;
+        }
+
+        // logically deleted; unlink here or leave it to the next traversal
+        uintptr_t expected = reinterpret_cast<uintptr_t>(pos.curr);
+        if (pos.prev->compare_exchange_strong(expected, next_word)) {
+            HazardPointers::retire(pos.curr);
+        } else {
+            ContentionStats::add(ContentionStats::CAS_FAILURES);
+            search(value, pos);
+        }
+        HazardPointers::clear();
+        return true;
+    }
+}
@@ -0,0 +1,49 @@
+#include "list_rwlock.h"
+#include <mutex>
+
+RWCoarseList::RWCoarseList(): head(nullptr) {}
+
+RWCoarseList::~RWCoarseList() {
+    std::unique_lock<std::shared_mutex> lg(mtx);
+    Node* cur = head;
+    while (cur) {
+        Node* tmp = cur;
+        cur = cur->next;
+        delete tmp;
+    }
+}
+
+bool RWCoarseList::insert(int value) {
+    std::unique_lock<std::shared_mutex> lg(mtx);
+    Node** curp = &head;
+    while (*curp && (*curp)->value < value) {
+        curp = &((*curp)->next);
+    }
+    if (*curp && (*curp)->value == value) return false;
+    Node* node = new Node(value);
+    node->next = *curp;
+    *curp = node;
+    return true;
+}
+
+bool RWCoarseList::remove(int value) {
+    std::unique_lock<std::shared_mutex> lg(mtx);
+    Node** curp = &head;
+    while (*curp && (*curp)->value < value) {
+        curp = &((*curp)->next);
+    }
+    if (!*curp || (*curp)->value != value) return false;
+    Node* to_del = *curp;
+    *curp = to_del->next;
+    delete to_del;
+    return true;
+}
+
+bool RWCoarseList::find(int value) {
+    std::shared_lock<std::shared_mutex> lg(mtx);
+    Node* cur = head;
+    while (cur && cur->value < value) {
+        cur = cur->next;
+    }
+    return cur && cur->value == value;
+}
@@ -0,0 +1,77 @@
+#include "list_seqlock.h"
+#include "epoch.h"
+#include <thread>
+
+SeqlockCoarseList::SeqlockCoarseList(): head(nullptr), seq(0) {}
+
+SeqlockCoarseList::~SeqlockCoarseList() {
+    std::lock_guard<std::mutex> lg(mtx);
+    Node* cur = head.load();
+    while (cur) {
+        Node* tmp = cur;
+        cur = cur->next.load();
+        delete tmp;
+    }
+}
+
+void SeqlockCoarseList::write_begin() {
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void SeqlockCoarseList::write_end() {
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool SeqlockCoarseList::insert(int value) {
+    std::lock_guard<std::mutex> lg(mtx);
+    std::atomic<Node*>* curp = &head;
+    Node* cur = curp->load(std::memory_order_relaxed);
+    while (cur && cur->value < value) {
+        curp = &cur->next;
+        cur = curp->load(std::memory_order_relaxed);
+    }
+    if (cur && cur->value == value) return false;
+    Node* node = new Node(value);
+    node->next.store(cur, std::memory_order_relaxed);
+    write_begin();
+    curp->store(node, std::memory_order_release);
+    write_end();
+    return true;
+}
+
+bool SeqlockCoarseList::remove(int value) {
+    std::lock_guard<std::mutex> lg(mtx);
+    std::atomic<Node*>* curp = &head;
+    Node* cur = curp->load(std::memory_order_relaxed);
+    while (cur && cur->value < value) {
+        curp = &cur->next;
+        cur = curp->load(std::memory_order_relaxed);
+    }
+    if (!cur || cur->value != value) return false;
+    write_begin();
+    curp->store(cur->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    write_end();
+    EpochReclaimer::retire(cur);
+    return true;
+}
+
+bool SeqlockCoarseList::find(int value) {
+    EpochReclaimer::Guard guard;
+    while (true) {
+        uint64_t before = seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        Node* cur = head.load(std::memory_order_acquire);
+        while (cur && cur->value < value) {
+            cur = cur->next.load(std::memory_order_acquire);
+        }
+        bool found = cur && cur->value == value;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == before) return found;
+    }
+}
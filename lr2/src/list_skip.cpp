@@ -0,0 +1,221 @@
+#include "list_skip.h"
+#include "epoch.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+
+SkipList::SkipList() {
+    head = new Node(std::numeric_limits<int>::min(), MAX_LEVEL - 1);
+    tail = new Node(std::numeric_limits<int>::max(), MAX_LEVEL - 1);
+    for (int level = 0; level < MAX_LEVEL; ++level) {
+        head->next[level].store(tail);
+    }
+    head->fully_linked.store(true);
+    tail->fully_linked.store(true);
+}
+
+SkipList::~SkipList() {
+    Node* cur = head;
+    while (cur) {
+        Node* tmp = cur->next[0].load();
+        delete cur;
+        cur = tmp;
+    }
+}
+
+// geometric with p = 1/2, from a per-thread xorshift generator
+int SkipList::random_level() {
+    static thread_local uint64_t state =
+        0x9E3779B97F4A7C15ULL ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    int level = 0;
+    uint64_t bits = state;
+    while ((bits & 1) && level < MAX_LEVEL - 1) {
+        ++level;
+        bits >>= 1;
+    }
+    return level;
+}
+
+// Fills preds/succs with the nodes around value on every level and returns the highest
+// level at which value was found, or -1.
+int SkipList::locate(int value, Node** preds, Node** succs) const {
+    int found = -1;
+    Node* pred = head;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+        Node* curr = pred->next[level].load(std::memory_order_acquire);
+        while (before(curr, value)) {
+            pred = curr;
+            curr = pred->next[level].load(std::memory_order_acquire);
+        }
+        if (found == -1 && holds(curr, value)) {
+            found = level;
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return found;
+}
+
+// preds repeat across adjacent levels, so each distinct node was locked once
+void SkipList::unlock_preds(Node** preds, int highest) {
+    Node* prev = nullptr;
+    for (int level = 0; level <= highest; ++level) {
+        if (preds[level] != prev) {
+            preds[level]->mtx.unlock();
+            prev = preds[level];
+        }
+    }
+}
+
+bool SkipList::find(int value) const {
+    EpochReclaimer::Guard guard;
+    Node* pred = head;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+        Node* curr = pred->next[level].load(std::memory_order_acquire);
+        while (before(curr, value)) {
+            pred = curr;
+            curr = pred->next[level].load(std::memory_order_acquire);
+        }
+        if (holds(curr, value)) {
+            return curr->fully_linked.load(std::memory_order_acquire) &&
+                   !curr->marked.load(std::memory_order_acquire);
+        }
+    }
+    return false;
+}
+
+bool SkipList::insert(int value) {
+    EpochReclaimer::Guard guard;
+    int top_level = random_level();
+    Node* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+
+    while (true) {
+        int found = locate(value, preds, succs);
+        if (found != -1) {
+            Node* node = succs[found];
+            if (!node->marked.load(std::memory_order_acquire)) {
+                // a concurrent insert of the same key; it is in the set once fully linked
+                while (!node->fully_linked.load(std::memory_order_acquire)) std::this_thread::yield();
+                return false;
+            }
+            continue;
+        }
+
+        int highest = -1;
+        bool valid = true;
+        Node* prev = nullptr;
+        for (int level = 0; valid && level <= top_level; ++level) {
+            Node* pred = preds[level];
+            Node* succ = succs[level];
+            if (pred != prev) {
+                pred->mtx.lock();
+                prev = pred;
+            }
+            highest = level;
+            valid = !pred->marked.load(std::memory_order_acquire) &&
+                    !succ->marked.load(std::memory_order_acquire) &&
+                    pred->next[level].load(std::memory_order_acquire) == succ;
+        }
+        if (!valid) {
+            unlock_preds(preds, highest);
+            continue;
+        }
+
+        Node* node = new Node(value, top_level);
+        for (int level = 0; level <= top_level; ++level) {
+            node->next[level].store(succs[level], std::memory_order_relaxed);
+        }
+        for (int level = 0; level <= top_level; ++level) {
+            preds[level]->next[level].store(node, std::memory_order_release);
+        }
+        node->fully_linked.store(true, std::memory_order_release);
+        unlock_preds(preds, highest);
+        return true;
+    }
+}
+
+bool SkipList::remove(int value) {
+    EpochReclaimer::Guard guard;
+    Node* victim = nullptr;
+    bool is_marked = false;
+    int top_level = -1;
+    Node* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+
+    while (true) {
+        int found = locate(value, preds, succs);
+        if (!is_marked) {
+            if (found == -1) return false;
+            victim = succs[found];
+            // only a fully linked node found at its top level can be deleted
+            if (!victim->fully_linked.load(std::memory_order_acquire) ||
+                victim->top_level != found ||
+                victim->marked.load(std::memory_order_acquire)) {
+                return false;
+            }
+            top_level = victim->top_level;
+            victim->mtx.lock();
+            if (victim->marked.load(std::memory_order_acquire)) {
+                victim->mtx.unlock();
+                return false;
+            }
+            victim->marked.store(true, std::memory_order_release);
+            is_marked = true;
+        }
+
+        int highest = -1;
+        bool valid = true;
+        Node* prev = nullptr;
+        for (int level = 0; valid && level <= top_level; ++level) {
+            Node* pred = preds[level];
+            if (pred != prev) {
+                pred->mtx.lock();
+                prev = pred;
+            }
+            highest = level;
+            valid = !pred->marked.load(std::memory_order_acquire) &&
+                    pred->next[level].load(std::memory_order_acquire) == victim;
+        }
+        if (!valid) {
+            unlock_preds(preds, highest);
+            continue;
+        }
+
+        for (int level = top_level; level >= 0; --level) {
+            preds[level]->next[level].store(victim->next[level].load(std::memory_order_relaxed),
+                                            std::memory_order_release);
+        }
+        victim->mtx.unlock();
+        unlock_preds(preds, highest);
+        EpochReclaimer::retire(victim);
+        return true;
+    }
+}
+
+std::vector<int> SkipList::range(int lo, int hi) const {
+    EpochReclaimer::Guard guard;
+    std::vector<int> out;
+    Node* pred = head;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+        Node* curr = pred->next[level].load(std::memory_order_acquire);
+        while (before(curr, lo)) {
+            pred = curr;
+            curr = pred->next[level].load(std::memory_order_acquire);
+        }
+    }
+
+    Node* curr = pred->next[0].load(std::memory_order_acquire);
+    while (curr != tail && curr->value <= hi) {
+        if (curr->fully_linked.load(std::memory_order_acquire) &&
+            !curr->marked.load(std::memory_order_acquire)) {
+            out.push_back(curr->value);
+        }
+        curr = curr->next[0].load(std::memory_order_acquire);
+    }
+    return out;
+}
@@ -0,0 +1,215 @@
+#include "list_snapshot.h"
+#include "epoch.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+SnapshotList::SnapshotList() : clock(1), removed(nullptr), removals(0) {
+    head = new Node(std::numeric_limits<int>::min());
+    tail = new Node(std::numeric_limits<int>::max());
+    head->next.store(tail);
+    for (auto& s : scans) s.store(0);
+}
+
+SnapshotList::~SnapshotList() {
+    Node* cur = head;
+    while (cur) {
+        Node* tmp = cur->next.load();
+        delete cur;
+        cur = tmp;
+    }
+    Node* node = removed.load();
+    while (node) {
+        Node* tmp = node->removed_next.load();
+        delete node;
+        node = tmp;
+    }
+}
+
+// Sets a node's insert or remove time if nobody has yet; whoever gets there first decides.
+uint64_t SnapshotList::stamp(std::atomic<uint64_t>& at) {
+    uint64_t value = at.load();
+    if (value == 0) {
+        uint64_t now = clock.load();
+        if (at.compare_exchange_strong(value, now)) return now;
+    }
+    return value;
+}
+
+void SnapshotList::locate(int value, Node*& pred, Node*& curr) const {
+    pred = head;
+    curr = head->next.load(std::memory_order_acquire);
+    while (curr != tail && curr->value < value) {
+        pred = curr;
+        curr = curr->next.load(std::memory_order_acquire);
+    }
+}
+
+bool SnapshotList::validate(Node* pred, Node* curr) const {
+    if (pred->marked.load(std::memory_order_acquire)) return false;
+    if (curr->marked.load(std::memory_order_acquire)) return false;
+    return pred->next.load(std::memory_order_acquire) == curr;
+}
+
+bool SnapshotList::find(int value) {
+    EpochReclaimer::Guard guard;
+    Node* pred;
+    Node* curr;
+    locate(value, pred, curr);
+    if (curr == tail || curr->value != value) return false;
+    stamp(curr->inserted_at);
+    if (curr->marked.load()) {
+        stamp(curr->removed_at);
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotList::insert(int value) {
+    EpochReclaimer::Guard guard;
+    while (true) {
+        Node* pred;
+        Node* curr;
+        locate(value, pred, curr);
+
+        std::unique_lock<std::mutex> lock_pred(pred->mtx);
+        std::unique_lock<std::mutex> lock_curr(curr->mtx);
+
+        if (!validate(pred, curr)) {
+            continue;
+        }
+
+        if (curr != tail && curr->value == value) {
+            stamp(curr->inserted_at);
+            return false;
+        }
+
+        Node* node = new Node(value);
+        node->next.store(curr, std::memory_order_relaxed);
+        pred->next.store(node, std::memory_order_release);
+        stamp(node->inserted_at);
+        return true;
+    }
+}
+
+bool SnapshotList::remove(int value) {
+    EpochReclaimer::Guard guard;
+    while (true) {
+        Node* pred;
+        Node* curr;
+        locate(value, pred, curr);
+
+        if (curr == tail || curr->value != value) {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock_pred(pred->mtx);
+        std::unique_lock<std::mutex> lock_curr(curr->mtx);
+
+        if (!validate(pred, curr)) {
+            continue;
+        }
+
+        stamp(curr->inserted_at);
+        curr->marked.store(true);
+        stamp(curr->removed_at);
+
+        // on the stack before it leaves the list, so a scan that walked past its position
+        // after the unlink is sure to find it there
+        Node* top = removed.load();
+        do {
+            curr->removed_next.store(top, std::memory_order_relaxed);
+        } while (!removed.compare_exchange_weak(top, curr));
+
+        pred->next.store(curr->next.load(std::memory_order_relaxed), std::memory_order_release);
+        curr->unlinked.store(true, std::memory_order_release);
+        lock_curr.unlock();
+        lock_pred.unlock();
+
+        if ((removals.fetch_add(1) & 63) == 63) trim();
+        return true;
+    }
+}
+
+bool SnapshotList::alive_at(Node* node, uint64_t ts) {
+    if (stamp(node->inserted_at) > ts) return false;
+    if (!node->marked.load()) return true;
+    return stamp(node->removed_at) > ts;
+}
+
+// Announces a lower bound before taking the timestamp: a trimmer that misses the
+// announcement read the clock earlier, so the timestamp is at least what it assumed.
+int SnapshotList::begin_scan(uint64_t& ts) {
+    while (true) {
+        for (int slot = 0; slot < MAX_SCANS; ++slot) {
+            uint64_t expected = 0;
+            if (scans[slot].load() == 0 && scans[slot].compare_exchange_strong(expected, clock.load())) {
+                ts = clock.fetch_add(1);
+                scans[slot].store(ts);
+                return slot;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+std::vector<int> SnapshotList::range(int lo, int hi) {
+    EpochReclaimer::Guard guard;
+    uint64_t ts;
+    int slot = begin_scan(ts);
+
+    std::vector<int> keys;
+    Node* pred;
+    Node* curr;
+    locate(lo, pred, curr);
+    while (curr != tail && curr->value <= hi) {
+        if (alive_at(curr, ts)) keys.push_back(curr->value);
+        curr = curr->next.load(std::memory_order_acquire);
+    }
+
+    // nodes removed after ts may have left the list before the walk reached them
+    for (Node* node = removed.load(); node; node = node->removed_next.load(std::memory_order_acquire)) {
+        if (node->value < lo || node->value > hi) continue;
+        if (stamp(node->removed_at) > ts && stamp(node->inserted_at) <= ts) {
+            keys.push_back(node->value);
+        }
+    }
+    scans[slot].store(0);
+
+    // a key can be seen twice (in the list and on the stack) but only one node per key is
+    // alive at ts
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+std::vector<int> SnapshotList::snapshot() {
+    return range(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+}
+
+// Retires stacked nodes removed no later than the oldest running scan. Only one thread trims
+// at a time and the top node stays, so pushes and concurrent stack walks are unaffected.
+void SnapshotList::trim() {
+    std::unique_lock<std::mutex> lock(trim_mtx, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+
+    uint64_t oldest = clock.load();
+    for (auto& s : scans) {
+        uint64_t ts = s.load();
+        if (ts != 0 && ts < oldest) oldest = ts;
+    }
+
+    Node* prev = removed.load();
+    if (!prev) return;
+    Node* node = prev->removed_next.load();
+    while (node) {
+        Node* next = node->removed_next.load();
+        if (node->unlinked.load() && node->removed_at.load() <= oldest) {
+            prev->removed_next.store(next, std::memory_order_release);
+            EpochReclaimer::retire(node);
+        } else {
+            prev = node;
+        }
+        node = next;
+    }
+}
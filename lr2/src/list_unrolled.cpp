@@ -0,0 +1,176 @@
+#include "list_unrolled.h"
+#include "contention.h"
+#include "epoch.h"
+#include <algorithm>
+#include <limits>
+
+UnrolledList::UnrolledList() {
+    head = new Node(std::numeric_limits<int>::min());
+}
+
+UnrolledList::~UnrolledList() {
+    Node* cur = head;
+    while (cur) {
+        Node* tmp = cur->next.load();
+        delete cur;
+        cur = tmp;
+    }
+}
+
+// Returns the node whose range covers value and sets pred to the node before it.
+UnrolledList::Node* UnrolledList::locate(int value, Node*& pred) const {
+    pred = nullptr;
+    Node* curr = head;
+    Node* next = curr->next.load(std::memory_order_acquire);
+    uint64_t steps = 0;
+    while (next && next->low <= value) {
+        pred = curr;
+        curr = next;
+        next = curr->next.load(std::memory_order_acquire);
+        ++steps;
+    }
+    ContentionStats::add(ContentionStats::NODES_TRAVERSED, steps);
+    return curr;
+}
+
+// node still covers value: read under its lock, or inside a version check
+bool UnrolledList::owns(Node* node, int value) const {
+    if (node->dead.load(std::memory_order_relaxed)) return false;
+    Node* next = node->next.load(std::memory_order_acquire);
+    return !next || value < next->low;
+}
+
+// index of the first key >= value among the first n
+int UnrolledList::position(Node* node, int n, int value) {
+    int pos = 0;
+    while (pos < n && node->keys[pos].load(std::memory_order_relaxed) < value) ++pos;
+    return pos;
+}
+
+bool UnrolledList::find(int value) {
+    EpochReclaimer::Guard guard;
+    while (true) {
+        Node* pred;
+        Node* curr = locate(value, pred);
+        uint64_t v = curr->lock.read_begin();
+        bool covered = owns(curr, value);
+        // a torn count is caught by the version check, but must not index past the array
+        int n = std::min(curr->count.load(std::memory_order_relaxed), int(CAPACITY));
+        int pos = position(curr, n, value);
+        bool found = pos < n && curr->keys[pos].load(std::memory_order_relaxed) == value;
+        if (curr->lock.read_validate(v) && covered) return found;
+        ContentionStats::add(ContentionStats::VALIDATE_RETRIES);
+    }
+}
+
+bool UnrolledList::insert(int value) {
+    EpochReclaimer::Guard guard;
+    while (true) {
+        Node* pred;
+        Node* curr = locate(value, pred);
+        auto lock = ContentionStats::acquire(curr->lock, ContentionStats::LOCK_NODE);
+        if (!owns(curr, value)) {
+            ContentionStats::add(ContentionStats::VALIDATE_RETRIES);
+            continue;
+        }
+
+        int n = curr->count.load(std::memory_order_relaxed);
+        int pos = position(curr, n, value);
+        if (pos < n && curr->keys[pos].load(std::memory_order_relaxed) == value) return false;
+
+        if (n == CAPACITY) {
+            split(curr, value);
+            return true;
+        }
+        for (int i = n; i > pos; --i) {
+            curr->keys[i].store(curr->keys[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        curr->keys[pos].store(value, std::memory_order_relaxed);
+        curr->count.store(n + 1, std::memory_order_relaxed);
+        return true;
+    }
+}
+
+// Moves the upper half of a full, locked node into a new successor and inserts value on the
+// proper side. The successor is complete before it is linked, so it needs no lock.
+void UnrolledList::split(Node* node, int value) {
+    int half = CAPACITY / 2;
+    Node* right = new Node(node->keys[half].load(std::memory_order_relaxed));
+    Node* target = value < right->low ? node : right;
+
+    int moved = 0;
+    for (int i = half; i < CAPACITY; ++i) {
+        right->keys[moved++].store(node->keys[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    right->count.store(moved, std::memory_order_relaxed);
+    node->count.store(half, std::memory_order_relaxed);
+
+    int n = target->count.load(std::memory_order_relaxed);
+    int pos = position(target, n, value);
+    for (int i = n; i > pos; --i) {
+        target->keys[i].store(target->keys[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    target->keys[pos].store(value, std::memory_order_relaxed);
+    target->count.store(n + 1, std::memory_order_relaxed);
+
+    right->next.store(node->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    node->next.store(right, std::memory_order_release);
+}
+
+bool UnrolledList::remove(int value) {
+    EpochReclaimer::Guard guard;
+    while (true) {
+        Node* pred;
+        Node* curr = locate(value, pred);
+        auto lock = ContentionStats::acquire(curr->lock, ContentionStats::LOCK_NODE);
+        if (!owns(curr, value)) {
+            ContentionStats::add(ContentionStats::VALIDATE_RETRIES);
+            continue;
+        }
+
+        int n = curr->count.load(std::memory_order_relaxed);
+        int pos = position(curr, n, value);
+        if (pos == n || curr->keys[pos].load(std::memory_order_relaxed) != value) return false;
+
+        for (int i = pos; i < n - 1; ++i) {
+            curr->keys[i].store(curr->keys[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        curr->count.store(n - 1, std::memory_order_relaxed);
+        if (n - 1 < MIN_FILL) shrink(pred, curr);
+        return true;
+    }
+}
+
+// Called with node locked. Absorbing the successor keeps lock order left to right; unlinking
+// an empty node needs its predecessor, which is only tried, since the caller already holds a
+// lock further right.
+void UnrolledList::shrink(Node* pred, Node* node) {
+    int n = node->count.load(std::memory_order_relaxed);
+    Node* next = node->next.load(std::memory_order_relaxed);
+    if (next) {
+        // next can only be merged away or unlinked under node's lock, so it is still live
+        auto next_lock = ContentionStats::acquire(next->lock, ContentionStats::LOCK_NODE);
+        int m = next->count.load(std::memory_order_relaxed);
+        if (n + m <= MERGE_LIMIT) {
+            for (int i = 0; i < m; ++i) {
+                node->keys[n + i].store(next->keys[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            node->count.store(n + m, std::memory_order_relaxed);
+            next->dead.store(true, std::memory_order_relaxed);
+            node->next.store(next->next.load(std::memory_order_relaxed), std::memory_order_release);
+            next_lock.unlock();
+            EpochReclaimer::retire(next);
+            return;
+        }
+    }
+
+    if (n > 0 || !pred || !pred->lock.try_lock()) return;
+    if (!pred->dead.load(std::memory_order_relaxed) && pred->next.load(std::memory_order_relaxed) == node) {
+        node->dead.store(true, std::memory_order_relaxed);
+        pred->next.store(next, std::memory_order_release);
+        pred->lock.unlock();
+        EpochReclaimer::retire(node);
+        return;
+    }
+    pred->lock.unlock();
+}
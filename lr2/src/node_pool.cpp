@@ -0,0 +1,249 @@
+#include "node_pool.h"
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct Batch {
+    FreeBlock* head;
+    size_t count;
+};
+
+struct GlobalClass {
+    std::mutex mtx;
+    std::vector<Batch> batches;
+};
+
+struct ThreadCache {
+    FreeBlock* free[NodePool::NUM_CLASSES] = {};
+    size_t free_count[NodePool::NUM_CLASSES] = {};
+    char* bump = nullptr;
+    char* bump_end = nullptr;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    int64_t live_bytes = 0;
+    size_t events = 0;
+};
+
+std::atomic<bool> pool_enabled{true};
+GlobalClass global_classes[NodePool::NUM_CLASSES];
+std::mutex slab_mtx;
+char* global_bump = nullptr;
+char* global_bump_end = nullptr;
+
+std::atomic<uint64_t> total_allocations{0};
+std::atomic<uint64_t> total_frees{0};
+std::atomic<int64_t> total_live{0};
+std::atomic<int64_t> total_peak{0};
+std::atomic<size_t> total_reserved{0};
+
+// the cache pointer is trivially destructible, so it stays readable after the holder runs
+thread_local ThreadCache* tl_cache = nullptr;
+thread_local bool tl_exited = false;
+
+const size_t class_size[NodePool::NUM_CLASSES] = {16, 32, 64, 128, 192, 256};
+
+// NUM_CLASSES for sizes the pool does not serve
+size_t class_of(size_t bytes) {
+    size_t cls = 0;
+    while (cls < NodePool::NUM_CLASSES && class_size[cls] < bytes) ++cls;
+    return cls;
+}
+
+char* new_slab() {
+    total_reserved.fetch_add(NodePool::SLAB_BYTES, std::memory_order_relaxed);
+    return static_cast<char*>(::operator new(NodePool::SLAB_BYTES, std::align_val_t(NodePool::CACHE_LINE)));
+}
+
+// classes share one bump pointer, so align it to the block (at most a cache line) first
+void* carve(char*& bump, char*& bump_end, size_t size) {
+    size_t align = size < NodePool::CACHE_LINE ? size : NodePool::CACHE_LINE;
+    uintptr_t at = (reinterpret_cast<uintptr_t>(bump) + align - 1) & ~uintptr_t(align - 1);
+    if (!bump || at + size > reinterpret_cast<uintptr_t>(bump_end)) {
+        bump = new_slab();
+        bump_end = bump + NodePool::SLAB_BYTES;
+        at = reinterpret_cast<uintptr_t>(bump);
+    }
+    bump = reinterpret_cast<char*>(at + size);
+    return reinterpret_cast<void*>(at);
+}
+
+void publish(ThreadCache* cache) {
+    total_allocations.fetch_add(cache->allocations, std::memory_order_relaxed);
+    total_frees.fetch_add(cache->frees, std::memory_order_relaxed);
+    int64_t live = total_live.fetch_add(cache->live_bytes, std::memory_order_relaxed) + cache->live_bytes;
+    int64_t peak = total_peak.load(std::memory_order_relaxed);
+    while (live > peak && !total_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    cache->allocations = cache->frees = 0;
+    cache->live_bytes = 0;
+    cache->events = 0;
+}
+
+void count(ThreadCache* cache, bool allocation, size_t bytes) {
+    if (allocation) {
+        ++cache->allocations;
+        cache->live_bytes += bytes;
+    } else {
+        ++cache->frees;
+        cache->live_bytes -= bytes;
+    }
+    if (++cache->events >= NodePool::BATCH) publish(cache);
+}
+
+void give_back(size_t cls, FreeBlock* head, size_t n) {
+    if (!head) return;
+    std::lock_guard<std::mutex> lg(global_classes[cls].mtx);
+    global_classes[cls].batches.push_back({head, n});
+}
+
+// Threads that already exited (their epoch or hazard records free nodes late) and the
+// pool itself use the global structures directly.
+void* allocate_global(size_t cls) {
+    GlobalClass& gc = global_classes[cls];
+    {
+        std::lock_guard<std::mutex> lg(gc.mtx);
+        if (!gc.batches.empty()) {
+            Batch& b = gc.batches.back();
+            FreeBlock* block = b.head;
+            b.head = block->next;
+            if (--b.count == 0) gc.batches.pop_back();
+            return block;
+        }
+    }
+    size_t size = class_size[cls];
+    std::lock_guard<std::mutex> lg(slab_mtx);
+    return carve(global_bump, global_bump_end, size);
+}
+
+struct CacheHolder {
+    ~CacheHolder() {
+        ThreadCache* cache = tl_cache;
+        if (!cache) return;
+        for (size_t cls = 0; cls < NodePool::NUM_CLASSES; ++cls) {
+            give_back(cls, cache->free[cls], cache->free_count[cls]);
+        }
+        // the rest of the private slab is dropped; it is at most one slab per thread
+        publish(cache);
+        delete cache;
+        tl_cache = nullptr;
+        tl_exited = true;
+    }
+};
+
+thread_local CacheHolder tl_holder;
+
+ThreadCache* local_cache() {
+    if (tl_cache) return tl_cache;
+    if (tl_exited) return nullptr;
+    (void)&tl_holder;
+    tl_cache = new ThreadCache();
+    return tl_cache;
+}
+
+} // namespace
+
+void NodePool::set_enabled(bool enabled) {
+    assert(enabled == NodePool::enabled() || stats().live_bytes == 0);
+    pool_enabled.store(enabled);
+}
+
+bool NodePool::enabled() {
+    return pool_enabled.load(std::memory_order_relaxed);
+}
+
+void* NodePool::allocate(size_t bytes) {
+    ThreadCache* cache = local_cache();
+    size_t cls = class_of(bytes);
+    bool pooled = enabled() && cls < NUM_CLASSES;
+    size_t size = pooled ? class_size[cls] : bytes;
+
+    if (!cache) {
+        total_allocations.fetch_add(1, std::memory_order_relaxed);
+        total_live.fetch_add(size, std::memory_order_relaxed);
+        return pooled ? allocate_global(cls) : ::operator new(bytes);
+    }
+    count(cache, true, size);
+    if (!pooled) return ::operator new(bytes);
+
+    if (!cache->free[cls]) {
+        std::lock_guard<std::mutex> lg(global_classes[cls].mtx);
+        std::vector<Batch>& batches = global_classes[cls].batches;
+        if (!batches.empty()) {
+            cache->free[cls] = batches.back().head;
+            cache->free_count[cls] = batches.back().count;
+            batches.pop_back();
+        }
+    }
+    if (FreeBlock* block = cache->free[cls]) {
+        cache->free[cls] = block->next;
+        --cache->free_count[cls];
+        return block;
+    }
+
+    return carve(cache->bump, cache->bump_end, size);
+}
+
+void NodePool::deallocate(void* p, size_t bytes) {
+    ThreadCache* cache = local_cache();
+    size_t cls = class_of(bytes);
+    bool pooled = enabled() && cls < NUM_CLASSES;
+    size_t size = pooled ? class_size[cls] : bytes;
+
+    if (!cache) {
+        total_frees.fetch_add(1, std::memory_order_relaxed);
+        total_live.fetch_sub(size, std::memory_order_relaxed);
+        if (pooled) {
+            FreeBlock* block = static_cast<FreeBlock*>(p);
+            block->next = nullptr;
+            give_back(cls, block, 1);
+        } else {
+            ::operator delete(p);
+        }
+        return;
+    }
+    count(cache, false, size);
+    if (!pooled) {
+        ::operator delete(p);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = cache->free[cls];
+    cache->free[cls] = block;
+
+    // keep one batch for local reuse and return the next one whole
+    if (++cache->free_count[cls] >= 2 * BATCH) {
+        FreeBlock* head = cache->free[cls];
+        FreeBlock* last = head;
+        for (size_t i = 1; i < BATCH; ++i) last = last->next;
+        cache->free[cls] = last->next;
+        cache->free_count[cls] -= BATCH;
+        last->next = nullptr;
+        give_back(cls, head, BATCH);
+    }
+}
+
+PoolStats NodePool::stats() {
+    if (ThreadCache* cache = local_cache()) publish(cache);
+    PoolStats s;
+    s.allocations = total_allocations.load();
+    s.frees = total_frees.load();
+    int64_t live = total_live.load();
+    s.live_bytes = live > 0 ? size_t(live) : 0;
+    int64_t peak = total_peak.load();
+    s.peak_bytes = peak > 0 ? size_t(peak) : 0;
+    s.reserved_bytes = total_reserved.load();
+    return s;
+}
+
+void NodePool::reset_peak() {
+    if (ThreadCache* cache = local_cache()) publish(cache);
+    total_peak.store(total_live.load());
+}
@@ -0,0 +1,48 @@
+#include "perf_counter.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+CacheMissCounter::CacheMissCounter() {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+CacheMissCounter::~CacheMissCounter() {
+    if (fd >= 0) close(fd);
+}
+
+void CacheMissCounter::start() {
+    if (fd < 0) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+int64_t CacheMissCounter::stop() {
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    uint64_t count = 0;
+    if (read(fd, &count, sizeof(count)) != ssize_t(sizeof(count))) return -1;
+    return int64_t(count);
+}
+
+#else
+
+CacheMissCounter::CacheMissCounter() : fd(-1) {}
+CacheMissCounter::~CacheMissCounter() {}
+void CacheMissCounter::start() {}
+int64_t CacheMissCounter::stop() { return -1; }
+
+#endif
@@ -0,0 +1,116 @@
+#include "workload.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+static std::vector<std::string> split(const std::string& text, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, sep)) parts.push_back(item);
+    return parts;
+}
+
+bool WorkloadSpec::parse(const std::string& text) {
+    std::vector<std::string> parts = split(text, ':');
+    if (parts.empty()) return false;
+    try {
+        if (parts[0] == "uniform" && parts.size() == 1) {
+            dist = KeyDistribution::Uniform;
+        } else if (parts[0] == "sequential" && parts.size() == 1) {
+            dist = KeyDistribution::Sequential;
+        } else if (parts[0] == "zipf" && parts.size() <= 2) {
+            dist = KeyDistribution::Zipf;
+            if (parts.size() == 2) zipf_theta = std::stod(parts[1]);
+            if (zipf_theta <= 0 || zipf_theta >= 1) return false;
+        } else if (parts[0] == "hotspot" && (parts.size() == 1 || parts.size() == 3)) {
+            dist = KeyDistribution::Hotspot;
+            if (parts.size() == 3) {
+                hot_fraction = std::stod(parts[1]);
+                hot_probability = std::stod(parts[2]);
+            }
+            if (hot_fraction <= 0 || hot_fraction >= 1) return false;
+            if (hot_probability < 0 || hot_probability > 1) return false;
+        } else {
+            return false;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+void WorkloadSpec::prepare() {
+    if (dist != KeyDistribution::Zipf) return;
+    zetan = 0;
+    for (int i = 1; i <= key_range; ++i) {
+        zetan += 1.0 / std::pow(double(i), zipf_theta);
+    }
+}
+
+std::string WorkloadSpec::describe() const {
+    std::ostringstream out;
+    switch (dist) {
+        case KeyDistribution::Uniform: out << "uniform"; break;
+        case KeyDistribution::Sequential: out << "sequential"; break;
+        case KeyDistribution::Zipf: out << "zipf:" << zipf_theta; break;
+        case KeyDistribution::Hotspot: out << "hotspot:" << hot_fraction << ":" << hot_probability; break;
+    }
+    return out.str();
+}
+
+KeyGenerator::KeyGenerator(const WorkloadSpec& spec, int tid, int threads, uint32_t seed)
+    : spec(spec), rng(seed), unit(0.0, 1.0), uniform(1, spec.key_range),
+      zeta2(0), alpha(0), eta(0) {
+    if (spec.dist == KeyDistribution::Zipf) {
+        zeta2 = 1.0 + std::pow(0.5, spec.zipf_theta);
+        alpha = 1.0 / (1.0 - spec.zipf_theta);
+        eta = (1.0 - std::pow(2.0 / spec.key_range, 1.0 - spec.zipf_theta)) / (1.0 - zeta2 / spec.zetan);
+    }
+
+    stripe_size = std::max<int64_t>(1, spec.key_range / std::max(1, threads));
+    stripe_begin = (int64_t(tid) * stripe_size) % spec.key_range;
+    cursor = 0;
+}
+
+// Gray et al., "Quickly generating billion-record synthetic databases" (as used by YCSB);
+// returns a rank in [0, key_range)
+int64_t KeyGenerator::zipf_rank() {
+    double u = unit(rng);
+    double uz = u * spec.zetan;
+    if (uz < 1.0) return 0;
+    if (uz < zeta2) return 1;
+    int64_t rank = int64_t(spec.key_range * std::pow(eta * u - eta + 1.0, alpha));
+    return std::min<int64_t>(rank, spec.key_range - 1);
+}
+
+// multiplication by a prime larger than any key range is a permutation modulo key_range
+int KeyGenerator::scramble(int64_t rank) const {
+    return int((uint64_t(rank) * 2654435761ULL) % uint64_t(spec.key_range)) + 1;
+}
+
+int KeyGenerator::next() {
+    switch (spec.dist) {
+        case KeyDistribution::Uniform:
+            return uniform(rng);
+        case KeyDistribution::Zipf:
+            return scramble(zipf_rank());
+        case KeyDistribution::Hotspot: {
+            int64_t hot = std::max<int64_t>(1, int64_t(spec.hot_fraction * spec.key_range));
+            int64_t rank;
+            if (unit(rng) < spec.hot_probability || hot == spec.key_range) {
+                rank = int64_t(unit(rng) * hot);
+            } else {
+                rank = hot + int64_t(unit(rng) * (spec.key_range - hot));
+            }
+            return scramble(std::min<int64_t>(rank, spec.key_range - 1));
+        }
+        case KeyDistribution::Sequential: {
+            int64_t key = (stripe_begin + cursor) % spec.key_range;
+            cursor = (cursor + 1) % stripe_size;
+            return int(key) + 1;
+        }
+    }
+    return 1;
+}